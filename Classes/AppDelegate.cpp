@@ -1,21 +1,62 @@
 #include "AppDelegate.h"
 #include "HelloWorldScene.h"
+#include "SimpleAudioEngine.h"
 
 //Wrapper Classes
 #include "InputHandler.h"
 #include "DisplayHandler.h"
+#include "ResourceHandler.h"
+#include "StartupTracer.h"
+#include "Logger.h"
+#include "HotReloader.h"
 
 USING_NS_CC;
 
+//--- Constants ---//
+static const std::string RESUME_AUDIO_KEY = "AppDelegate_ResumeAudio"; //The scheduler key for the delayed audio resume after coming back to the foreground
+static const float BACKGROUND_FRAME_INTERVAL = 0.5f; //How often (in seconds) the main loop wakes up while minimized. Only window events are polled during these wake ups
+
+
+
 //--- Constructors and Destructors ---//
 AppDelegate::AppDelegate()
 {
+	//Start the startup timer. This is the earliest point our code runs so every phase is measured from here
+	STARTUP->begin();
+
+	//Init the background settings. By default, everything unused gets purged when minimized
+	purgeCachesInBackground = true;
+	backgroundMemoryBudget = 0;
+	isSuspended = false;
+	pausedByBackground = false;
 }
 
 AppDelegate::~AppDelegate()
 {
+	//Stop the asset watcher thread if it was started
+	HOTRELOAD->stop();
+
+	//Write out any log messages that are still waiting and stop the logging thread
+	LOGGER->shutdown();
+}
+
+
+
+//--- Setters ---//
+void AppDelegate::setPurgeCachesInBackground(bool purgeCaches)
+{
+	//Set the flag that determines if the caches are trimmed when the game is minimized
+	purgeCachesInBackground = purgeCaches;
 }
 
+void AppDelegate::setBackgroundMemoryBudget(size_t budgetInBytes)
+{
+	//Set how many bytes of textures are allowed to stay loaded while minimized
+	backgroundMemoryBudget = budgetInBytes;
+}
+
+
+
 //--- Virtual Methods ---//
 bool AppDelegate::applicationDidFinishLaunching()
 {
@@ -24,20 +65,47 @@ bool AppDelegate::applicationDidFinishLaunching()
 	//The title of the window is "Template". This shows up on the toolbar at the top of the window
 	//We do not want it fullscreen right now. If we did, our resolution parameters would be overwritten
 	//The 2.0x zoom factor simply scales up our window so it is easier to see and work with. The window itself is 2x the size as well as everything being drawn inside it
+	//Each step of the startup is wrapped in a phase so we can see which one is slowing down the launch. The report is printed once the first frame is on screen
+	STARTUP->beginPhase("GL View Creation");
 	DISPLAY->init(640, 480, "Template", false, 2.0f);
+	STARTUP->endPhase();
+
+	//Finish the startup trace as soon as the first frame has been swapped onto the screen
+	DISPLAY->addPresentCallback([]()
+	{
+		STARTUP->finish();
+	});
+
+	//Set how much memory the textures, fonts and sounds are allowed to use
+	//Assets loaded through RESOURCES-> are counted. Once they go over this, the least recently used ones that aren't on screen are unloaded
+	//Pass in 0 if you never want assets unloaded automatically
+	RESOURCES->setMemoryBudget(256 * 1024 * 1024);
+
+	//Uncomment this to reload textures, fonts and data files as soon as they are saved, without restarting the game (Linux only)
+	//It is off by default and costs nothing until it is started
+	//HOTRELOAD->start();
 
 	//Create our main scene and tell the director to use it
 	//The director is Cocos2D's game management system. It controls the scene switching, creating, etc. It is a singleton so there is only one instance of the class and it can be used everywhere
 	//We are creating a new version of our demo scene and then telling the director to start using it
+	//The demo scene doesn't use physics so it is created without a physics world. Physics, audio and fonts are only started up once something actually uses them
+	STARTUP->beginPhase("First Scene Construction");
 	Director* director = Director::getInstance();
 	Scene* scene = HelloWorld::createScene();
 	director->runWithScene(scene);
+	STARTUP->endPhase();
 
 	//Set up the input handler
 	//This is another singleton so you can't make more than one instance of this class
 	//INPUTS is actually a macro. It represents InputHandler::getInstance() which is exactly the same as the Director::getInstance() function we used above
 	//This is a simple input handler to prevent having to handle the Cocos2D events yourself
+	//Use INPUTS->init(InputBackend::GLFWPolling) instead to read the keyboard and mouse straight from the window, skipping the Cocos2D event dispatcher
+	STARTUP->beginPhase("InputHandler Init");
 	INPUTS->init();
+	STARTUP->endPhase();
+
+	//Everything after this point, up until the first frame is on screen, is the engine preparing and drawing that frame
+	STARTUP->beginPhase("First Frame Presented");
 
 	//Indicate everything succeeded with the launch
 	return true;
@@ -50,7 +118,41 @@ void AppDelegate::applicationDidEnterBackground()
 	//On mobile phones, this would be when the app is still running but the user has switched to a different app (ex: they answer a phone call)
 	//On Windows, this is called when the user minimizes the game window
 	//Some practical usage of this would to be pause the game until they come back. You can call director->pause() here to do just that.
-	std::cout << "Entering Background..." << std::endl;
+	LOG_INFO("Entering Background...");
+
+	//Don't suspend twice if the platform sends the event more than once
+	if (isSuspended)
+		return;
+
+	isSuspended = true;
+
+	//If we came back and left again before the audio had a chance to resume, cancel the pending resume
+	Director* director = Director::getInstance();
+	director->getScheduler()->unschedule(RESUME_AUDIO_KEY, this);
+
+	//Pause the director. This stops the scheduler so no update() functions or actions are run
+	//If the game already paused the director itself (ex: a pause menu), leave it alone and remember that so it stays paused when we come back
+	//Then stop the animation so the scene is no longer drawn
+	pausedByBackground = !director->isPaused();
+
+	if (pausedByBackground)
+		director->pause();
+
+	director->stopAnimation();
+
+	//Slow the main loop right down. It only needs to wake up to check if the window has been restored
+	setAnimationInterval(BACKGROUND_FRAME_INTERVAL);
+
+	//Pause all of the sounds. If nothing has played any audio, skip this so the audio engine isn't started just to be paused
+	if (RESOURCES->hasUsedAudio())
+	{
+		CocosDenshion::SimpleAudioEngine::getInstance()->pauseBackgroundMusic();
+		CocosDenshion::SimpleAudioEngine::getInstance()->pauseAllEffects();
+	}
+
+	//Free up the memory that isn't being used so other programs can use it while we are minimized
+	if (purgeCachesInBackground)
+		trimCachesToBudget();
 }
 
 void AppDelegate::applicationWillEnterForeground()
@@ -60,6 +162,82 @@ void AppDelegate::applicationWillEnterForeground()
 	//On mobile phones, this would be when the app is still running and the user has switched back to it (ex: they finished with their phone call)
 	//On Windows, this is called when the user selects the window again after minimizing it
 	//This would be a good place to unpause the game if you had paused it or to perform other setup stuff like getting the music ready again
-	std::cout << "Entering Foreground..." << std::endl;
+	LOG_INFO("Entering Foreground...");
+
+	//Nothing to resume if we were never suspended
+	if (!isSuspended)
+		return;
+
+	isSuspended = false;
+
+	//Restore everything in order of priority. The most important thing is getting the window drawing again so the player isn't looking at a frozen frame
+	//Resume first so the director restores its normal frame rate, then start the animation which passes that frame rate back to the main loop
+	//Only resume if we were the ones who paused the director. A game that was paused before it was minimized comes back still paused
+	Director* director = Director::getInstance();
+
+	if (pausedByBackground)
+		director->resume();
+
+	director->startAnimation();
+
+	//Purged textures and glyphs don't need to be restored here. They are reloaded automatically the next time something uses them
+	if (RESOURCES->hasUsedAudio())
+	{
+		auto resumeAudio = [](float deltaTime)
+		{
+			CocosDenshion::SimpleAudioEngine::getInstance()->resumeBackgroundMusic();
+			CocosDenshion::SimpleAudioEngine::getInstance()->resumeAllEffects();
+		};
+
+		//The audio is resumed on the next frame so it doesn't compete with the first redraw
+		//A paused director never ticks its scheduler though, so if the game was already paused the audio is resumed right away instead
+		if (pausedByBackground)
+			director->getScheduler()->schedule(resumeAudio, this, 0.0f, 0, 0.0f, false, RESUME_AUDIO_KEY);
+		else
+			resumeAudio(0.0f);
+	}
+}
+
+
+
+//--- Utility Functions ---//
+void AppDelegate::trimCachesToBudget()
+{
+	//Purge the caches one at a time, starting with the ones that are cheapest to rebuild. Stop as soon as the textures fit inside the budget
+	//Sprite frames are just rectangles pointing into textures but they keep those textures alive, so they go first
+	SpriteFrameCache::getInstance()->removeUnusedSpriteFrames();
+	GLProgramStateCache::getInstance()->removeUnusedGLProgramState();
+
+	if (getTextureMemoryUsage() <= backgroundMemoryBudget)
+		return;
+
+	//Font glyph atlases are rebuilt by the labels that use them the next time they are drawn
+	FontAtlasCache::purgeCachedData();
+
+	if (getTextureMemoryUsage() <= backgroundMemoryBudget)
+		return;
+
+	//Next, unload the tracked assets that haven't been used in the longest time
+	RESOURCES->trimToBudget(backgroundMemoryBudget);
+
+	if (getTextureMemoryUsage() <= backgroundMemoryBudget)
+		return;
+
+	//Finally, release any texture that nothing is using anymore. These are reloaded from disk if they are needed again
+	Director::getInstance()->getTextureCache()->removeUnusedTextures();
+}
+
+size_t AppDelegate::getTextureMemoryUsage() const
+{
+	//The texture cache only reports its total size as part of its debug info. The last line reads "TextureCache dumpDebugInfo: X textures, for Y KB (Z MB)"
+	std::string info = Director::getInstance()->getTextureCache()->getCachedTextureInfo();
+	size_t totalPosition = info.rfind("for ");
+
+	//If the line couldn't be found, assume the cache is over budget so everything unused gets purged
+	if (totalPosition == std::string::npos)
+		return SIZE_MAX;
+
+	//Convert from kilobytes to bytes
+	return (size_t)strtoul(info.c_str() + totalPosition + 4, nullptr, 10) * 1024;
 }
 
@@ -8,9 +8,34 @@ public:
 	AppDelegate();
 	virtual ~AppDelegate();
 
+	//--- Setters ---//
+	/*
+		Set whether or not the unused caches (sprite frames, font glyph atlases, textures, program states) are purged when the game is minimized. It is TRUE by default
+
+		@param PurgeCaches -> If true, unused cached resources are released when entering the background so other programs can use the memory
+	*/
+	void setPurgeCachesInBackground(bool purgeCaches);
+
+	/*
+		Set how many bytes of textures are allowed to stay resident while the game is in the background. Caches are purged in order of priority until the textures fit inside this budget
+
+		@param BudgetInBytes -> The texture memory budget while minimized. 0 means purge every unused texture
+	*/
+	void setBackgroundMemoryBudget(size_t budgetInBytes);
+
 	//--- Virtual Methods ---//
 	virtual bool applicationDidFinishLaunching(); //The main initialization function. This is called when the game is just starting up
 	virtual void applicationDidEnterBackground(); //Called when the game is minimized or put into the background
 	virtual void applicationWillEnterForeground(); //Called when the game is re-enabled after being minimized
-};
 
+private:
+	//--- Private Data ---//
+	bool purgeCachesInBackground; //If true, unused caches are purged when the game goes into the background
+	size_t backgroundMemoryBudget; //The number of bytes of textures that can stay loaded while in the background
+	bool isSuspended; //True while the game is in the background. Prevents suspending or resuming twice
+	bool pausedByBackground; //True if the director was paused when going into the background, rather than already being paused by the game
+
+	//--- Utility Functions ---//
+	void trimCachesToBudget(); //Purges the caches one at a time, cheapest to rebuild first, until the textures fit inside the background budget
+	size_t getTextureMemoryUsage() const; //Returns the number of bytes currently held by the texture cache
+};
@@ -0,0 +1,145 @@
+#include "CollisionBenchmark.h"
+#include "CollisionWorld.h"
+#include "Logger.h"
+
+//Core Libraries
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+
+//3rd Party Libraries
+#include "cocos2d.h"
+
+//Namespaces
+using namespace cocos2d;
+
+//--- Constants ---//
+static const float BENCHMARK_TIMESTEP = 1.0f / 60.0f; //Both worlds are stepped at a fixed 60 fps
+static const float BODY_SPACING = 24.0f; //The play area grows with the body count so the number of contacts per body stays about the same
+
+
+
+//--- Methods ---//
+double CollisionBenchmark::run(unsigned int bodyCount, unsigned int frames)
+{
+	std::vector<BenchmarkBody> bodies = createBodies(bodyCount);
+
+	double collisionWorldMs = timeCollisionWorld(bodies, frames);
+	double chipmunkMs = timeChipmunk(bodies, frames);
+	double speedup = chipmunkMs / std::max(collisionWorldMs, 0.000001);
+
+	//Print the results
+	LOG_INFO("Collision benchmark: {} bodies, {} frames", bodyCount, frames);
+	LOG_INFO("\tCollisionWorld: {} ms per frame", collisionWorldMs);
+	LOG_INFO("\tChipmunk PhysicsWorld: {} ms per frame", chipmunkMs);
+	LOG_INFO("\tCollisionWorld (moving + pushing apart only) is {}x faster than a full Chipmunk step", speedup);
+
+	return speedup;
+}
+
+
+
+//--- Utility Functions ---//
+std::vector<BenchmarkBody> CollisionBenchmark::createBodies(unsigned int bodyCount)
+{
+	std::vector<BenchmarkBody> bodies(bodyCount);
+	float areaSize = sqrtf((float)bodyCount) * BODY_SPACING;
+
+	//A fixed xorshift seed so both worlds, and every run, get the exact same bodies
+	unsigned int randomState = 0x9E3779B9;
+	auto random01 = [&randomState]()
+	{
+		randomState ^= randomState << 13;
+		randomState ^= randomState >> 17;
+		randomState ^= randomState << 5;
+		return (randomState >> 8) * (1.0f / 16777216.0f);
+	};
+
+	//Half circles and half boxes, spread over the area and moving in random directions
+	for (unsigned int i = 0; i < bodyCount; i++)
+	{
+		bodies[i].x = random01() * areaSize;
+		bodies[i].y = random01() * areaSize;
+		bodies[i].velocityX = (random01() - 0.5f) * 200.0f;
+		bodies[i].velocityY = (random01() - 0.5f) * 200.0f;
+		bodies[i].size = 4.0f + random01() * 4.0f;
+		bodies[i].isCircle = (i % 2) == 0;
+	}
+
+	return bodies;
+}
+
+double CollisionBenchmark::timeCollisionWorld(const std::vector<BenchmarkBody>& bodies, unsigned int frames)
+{
+	CollisionWorld world;
+	std::vector<ColliderID> colliders(bodies.size());
+
+	for (unsigned int i = 0; i < bodies.size(); i++)
+	{
+		const BenchmarkBody& body = bodies[i];
+		colliders[i] = body.isCircle ? world.addCircle(body.x, body.y, body.size) : world.addBox(body.x, body.y, body.size * 2.0f, body.size * 2.0f);
+	}
+
+	auto startTime = std::chrono::steady_clock::now();
+
+	for (unsigned int frame = 0; frame < frames; frame++)
+	{
+		//Move everything, then find the contacts and push them apart
+		//This is less work than PhysicsWorld::step(). Chipmunk also works out velocities and runs an impulse solver over every contact several times, so the two times are not a like-for-like comparison
+		for (unsigned int i = 0; i < bodies.size(); i++)
+		{
+			float x, y;
+			world.getPosition(colliders[i], x, y);
+			world.setPosition(colliders[i], x + bodies[i].velocityX * BENCHMARK_TIMESTEP, y + bodies[i].velocityY * BENCHMARK_TIMESTEP);
+		}
+
+		world.findContacts();
+		world.resolveContacts();
+	}
+
+	double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+	return totalMs / std::max(frames, 1u);
+}
+
+double CollisionBenchmark::timeChipmunk(const std::vector<BenchmarkBody>& bodies, unsigned int frames)
+{
+	//Create a physics scene that is never shown. It is retained so it isn't autoreleased before we are done
+	Scene* scene = Scene::createWithPhysics();
+	scene->retain();
+
+	//Step the world by hand with no gravity so it matches the CollisionWorld
+	PhysicsWorld* world = scene->getPhysicsWorld();
+	world->setGravity(Vec2::ZERO);
+	world->setAutoStep(false);
+
+	for (unsigned int i = 0; i < bodies.size(); i++)
+	{
+		const BenchmarkBody& body = bodies[i];
+		PhysicsBody* physicsBody = body.isCircle ? PhysicsBody::createCircle(body.size) : PhysicsBody::createBox(Size(body.size * 2.0f, body.size * 2.0f));
+		physicsBody->setGravityEnable(false);
+		physicsBody->setRotationEnable(false);
+		physicsBody->setVelocity(Vec2(body.velocityX, body.velocityY));
+
+		Node* node = Node::create();
+		node->setPosition(body.x, body.y);
+		node->setPhysicsBody(physicsBody);
+		scene->addChild(node);
+	}
+
+	//The bodies are only added to the world once the scene is entered. Step once so they are all in before the timing starts
+	scene->onEnter();
+	world->step(BENCHMARK_TIMESTEP);
+
+	auto startTime = std::chrono::steady_clock::now();
+
+	for (unsigned int frame = 0; frame < frames; frame++)
+		world->step(BENCHMARK_TIMESTEP);
+
+	double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+	//Clean up the scene and everything in it
+	scene->onExit();
+	scene->release();
+
+	return totalMs / std::max(frames, 1u);
+}
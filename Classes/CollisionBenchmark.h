@@ -0,0 +1,65 @@
+/*
+============================================================
+	Collision Benchmark:
+		- Times the CollisionWorld against Cocos2D's Chipmunk physics world with exactly the same bodies
+			> Both get the same mix of moving circles and boxes, spawned in the same places with the same velocities, with no gravity
+			> Each frame the CollisionWorld moves the bodies, finds every contact and pushes them apart. The Chipmunk world runs a full PhysicsWorld::step()
+			> PhysicsWorld::step() does more than that (it works out velocities and runs an impulse solver several times per contact), so the speedup is not a like-for-like comparison. It shows what you save by not using full physics when you only need overlaps
+			> The Chipmunk scene is never shown. It is stepped by hand so only the physics is timed, not the drawing
+		- Call it from anywhere once the director is set up. The results are printed to the console
+			> Ex: CollisionBenchmark::run(2000, 300);
+
+	Usage:
+		- You are free to use this class for the case studies and for GDW
+		- You are free to edit / overwrite any or all of this class
+			> It is simply here to make your life easier
+		- You must leave this comment block at the top of the header
+============================================================
+*/
+
+#ifndef COLLISIONBENCHMARK_H
+#define COLLISIONBENCHMARK_H
+
+//Core Libraries
+#include <vector>
+
+/*
+	Benchmark Body Struct
+	- A single body used by both sides of the benchmark
+*/
+struct BenchmarkBody
+{
+	float x, y; //Where the body starts
+	float velocityX, velocityY; //How fast it moves, in pixels per second
+	float size; //The radius for circles, half of the width and height for boxes
+	bool isCircle; //True for a circle, false for a box
+};
+
+
+
+/*
+	Collision Benchmark Class:
+	> Methods
+		- Run the benchmark
+*/
+class CollisionBenchmark
+{
+public:
+	//--- Methods ---//
+	/*
+		Time both worlds and print the results
+
+		@param BodyCount -> The number of bodies in each world. Ex: 2000
+		@param Frames -> The number of 60 fps frames to time
+		@return Returns -> How many times faster the CollisionWorld was than a full Chipmunk step. Chipmunk does more work per step, so this isn't a like-for-like comparison
+	*/
+	static double run(unsigned int bodyCount, unsigned int frames);
+
+private:
+	//--- Utility Functions ---//
+	static std::vector<BenchmarkBody> createBodies(unsigned int bodyCount); //Spawns the same bodies every time
+	static double timeCollisionWorld(const std::vector<BenchmarkBody>& bodies, unsigned int frames); //Returns the milliseconds per frame for the CollisionWorld
+	static double timeChipmunk(const std::vector<BenchmarkBody>& bodies, unsigned int frames); //Returns the milliseconds per frame for the Chipmunk world
+};
+
+#endif
@@ -0,0 +1,449 @@
+#include "CollisionWorld.h"
+
+//Core Libraries
+#include <cmath>
+#include <algorithm>
+
+//--- Constants ---//
+static const float MIN_DISTANCE = 0.0001f; //Distances smaller than this are treated as 0 so the normal is never divided by 0
+
+//--- Utility ---//
+//Returns 1 for positive numbers and 0, -1 for negative numbers
+static float signOf(float value)
+{
+	return (value < 0.0f) ? -1.0f : 1.0f;
+}
+
+//Tests an axis aligned box against a circle. The normal points from the box to the circle
+static bool testBoxCircle(float boxX, float boxY, float halfW, float halfH, float circleX, float circleY, float radius, float& normalX, float& normalY, float& depth)
+{
+	//Find the point on the box closest to the center of the circle
+	float closestX = std::max(boxX - halfW, std::min(circleX, boxX + halfW));
+	float closestY = std::max(boxY - halfH, std::min(circleY, boxY + halfH));
+	float dx = circleX - closestX;
+	float dy = circleY - closestY;
+	float distanceSquared = dx * dx + dy * dy;
+
+	if (distanceSquared >= radius * radius)
+		return false;
+
+	//The center is outside the box, so push along the line to the closest point
+	if (distanceSquared > MIN_DISTANCE * MIN_DISTANCE)
+	{
+		float distance = sqrtf(distanceSquared);
+		normalX = dx / distance;
+		normalY = dy / distance;
+		depth = radius - distance;
+		return true;
+	}
+
+	//The center is inside the box, so push out the shortest way along either axis
+	float overlapX = halfW - fabsf(circleX - boxX);
+	float overlapY = halfH - fabsf(circleY - boxY);
+
+	if (overlapX < overlapY)
+	{
+		normalX = signOf(circleX - boxX);
+		normalY = 0.0f;
+		depth = overlapX + radius;
+	}
+	else
+	{
+		normalX = 0.0f;
+		normalY = signOf(circleY - boxY);
+		depth = overlapY + radius;
+	}
+
+	return true;
+}
+
+
+
+//--- Constructors and Destructor ---//
+CollisionWorld::CollisionWorld()
+{
+	isOrderDirty = false;
+}
+
+CollisionWorld::~CollisionWorld()
+{
+	//Everything is stored in vectors so nothing needs to be cleaned up manually
+}
+
+
+
+//--- Setters ---//
+void CollisionWorld::setPosition(ColliderID id, float x, float y)
+{
+	if (!isValid(id))
+		return;
+
+	unsigned int index = idToDense[id];
+	posX[index] = x;
+	posY[index] = y;
+}
+
+void CollisionWorld::setSize(ColliderID id, float _halfWidth, float _halfHeight)
+{
+	if (!isValid(id))
+		return;
+
+	//Circles use the radius for both
+	unsigned int index = idToDense[id];
+	halfWidth[index] = _halfWidth;
+	halfHeight[index] = (shape[index] == ColliderShape::Circle) ? _halfWidth : _halfHeight;
+}
+
+void CollisionWorld::setLayer(ColliderID id, uint32_t _layer, uint32_t _mask)
+{
+	if (!isValid(id))
+		return;
+
+	unsigned int index = idToDense[id];
+	layer[index] = _layer;
+	mask[index] = _mask;
+}
+
+void CollisionWorld::setUserData(ColliderID id, void* _userData)
+{
+	if (!isValid(id))
+		return;
+
+	userData[idToDense[id]] = _userData;
+}
+
+
+
+//--- Getters ---//
+bool CollisionWorld::isValid(ColliderID id) const
+{
+	return id < idToDense.size() && idToDense[id] != INVALID_COLLIDER;
+}
+
+void CollisionWorld::getPosition(ColliderID id, float& x, float& y) const
+{
+	if (!isValid(id))
+		return;
+
+	unsigned int index = idToDense[id];
+	x = posX[index];
+	y = posY[index];
+}
+
+void* CollisionWorld::getUserData(ColliderID id) const
+{
+	return isValid(id) ? userData[idToDense[id]] : nullptr;
+}
+
+unsigned int CollisionWorld::getColliderCount() const
+{
+	return (unsigned int)posX.size();
+}
+
+const std::vector<CollisionContact>& CollisionWorld::getContacts() const
+{
+	return contacts;
+}
+
+
+
+//--- Methods ---//
+ColliderID CollisionWorld::addBox(float x, float y, float width, float height, uint32_t _layer, uint32_t _mask, bool _isStatic)
+{
+	return addCollider(ColliderShape::Box, x, y, width * 0.5f, height * 0.5f, _layer, _mask, _isStatic);
+}
+
+ColliderID CollisionWorld::addCircle(float x, float y, float radius, uint32_t _layer, uint32_t _mask, bool _isStatic)
+{
+	return addCollider(ColliderShape::Circle, x, y, radius, radius, _layer, _mask, _isStatic);
+}
+
+void CollisionWorld::removeCollider(ColliderID id)
+{
+	if (!isValid(id))
+		return;
+
+	//Move the last collider into the removed one's place so the arrays stay packed
+	unsigned int index = idToDense[id];
+	unsigned int last = (unsigned int)posX.size() - 1;
+
+	posX[index] = posX[last];
+	posY[index] = posY[last];
+	halfWidth[index] = halfWidth[last];
+	halfHeight[index] = halfHeight[last];
+	shape[index] = shape[last];
+	layer[index] = layer[last];
+	mask[index] = mask[last];
+	isStatic[index] = isStatic[last];
+	userData[index] = userData[last];
+	denseToID[index] = denseToID[last];
+	idToDense[denseToID[index]] = index;
+
+	posX.pop_back();
+	posY.pop_back();
+	halfWidth.pop_back();
+	halfHeight.pop_back();
+	shape.pop_back();
+	layer.pop_back();
+	mask.pop_back();
+	isStatic.pop_back();
+	userData.pop_back();
+	denseToID.pop_back();
+
+	//Free up the handle so it can be reused
+	idToDense[id] = INVALID_COLLIDER;
+	freeIDs.push_back(id);
+	isOrderDirty = true;
+}
+
+void CollisionWorld::clear()
+{
+	posX.clear();
+	posY.clear();
+	halfWidth.clear();
+	halfHeight.clear();
+	shape.clear();
+	layer.clear();
+	mask.clear();
+	isStatic.clear();
+	userData.clear();
+	denseToID.clear();
+	idToDense.clear();
+	freeIDs.clear();
+	sortedOrder.clear();
+	contacts.clear();
+	isOrderDirty = false;
+}
+
+const std::vector<CollisionContact>& CollisionWorld::findContacts()
+{
+	contacts.clear();
+
+	unsigned int count = getColliderCount();
+
+	//Work out the left and right edge of every collider in one straight pass
+	minX.resize(count);
+	maxX.resize(count);
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		minX[i] = posX[i] - halfWidth[i];
+		maxX[i] = posX[i] + halfWidth[i];
+	}
+
+	sortByLeftEdge();
+
+	//Sweep along the x axis. Each collider only needs to be compared with the ones that start before it ends
+	CollisionContact contact;
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		unsigned int a = sortedOrder[i];
+		float rightEdge = maxX[a];
+
+		for (unsigned int j = i + 1; j < count; j++)
+		{
+			unsigned int b = sortedOrder[j];
+
+			//Every collider after this one starts further to the right, so none of them can touch
+			if (minX[b] > rightEdge)
+				break;
+
+			//Static colliders never need to know about each other
+			if (isStatic[a] & isStatic[b])
+				continue;
+
+			//Both colliders have to want to touch each other
+			if (!(layer[a] & mask[b]) || !(layer[b] & mask[a]))
+				continue;
+
+			//The boxes overlap on x, so check y before doing the exact test
+			if (fabsf(posY[a] - posY[b]) > halfHeight[a] + halfHeight[b])
+				continue;
+
+			if (testPair(a, b, contact))
+				contacts.push_back(contact);
+		}
+	}
+
+	return contacts;
+}
+
+void CollisionWorld::resolveContacts(unsigned int iterations)
+{
+	CollisionContact contact;
+
+	for (unsigned int iteration = 0; iteration < iterations; iteration++)
+	{
+		for (unsigned int i = 0; i < contacts.size(); i++)
+		{
+			//The contact may have been removed since findContacts()
+			if (!isValid(contacts[i].colliderA) || !isValid(contacts[i].colliderB))
+				continue;
+
+			unsigned int a = idToDense[contacts[i].colliderA];
+			unsigned int b = idToDense[contacts[i].colliderB];
+
+			//Earlier pushes may have already moved these two apart, so test them again with where they are now
+			if (!testPair(a, b, contact))
+				continue;
+
+			//Static colliders don't move, so the other one has to move the whole way
+			float moveA = isStatic[a] ? 0.0f : 1.0f;
+			float moveB = isStatic[b] ? 0.0f : 1.0f;
+			float totalMove = moveA + moveB;
+
+			if (totalMove == 0.0f)
+				continue;
+
+			float push = contact.depth / totalMove;
+			posX[a] -= contact.normalX * push * moveA;
+			posY[a] -= contact.normalY * push * moveA;
+			posX[b] += contact.normalX * push * moveB;
+			posY[b] += contact.normalY * push * moveB;
+		}
+	}
+}
+
+
+
+//--- Utility Functions ---//
+ColliderID CollisionWorld::addCollider(ColliderShape colliderShape, float x, float y, float halfW, float halfH, uint32_t colliderLayer, uint32_t colliderMask, bool colliderIsStatic)
+{
+	//Reuse an old handle if there is one
+	ColliderID id;
+
+	if (!freeIDs.empty())
+	{
+		id = freeIDs.back();
+		freeIDs.pop_back();
+	}
+	else
+	{
+		id = (ColliderID)idToDense.size();
+		idToDense.push_back(INVALID_COLLIDER);
+	}
+
+	//Add the collider to the end of every array
+	idToDense[id] = (unsigned int)posX.size();
+	posX.push_back(x);
+	posY.push_back(y);
+	halfWidth.push_back(halfW);
+	halfHeight.push_back(halfH);
+	shape.push_back(colliderShape);
+	layer.push_back(colliderLayer);
+	mask.push_back(colliderMask);
+	isStatic.push_back(colliderIsStatic ? 1 : 0);
+	userData.push_back(nullptr);
+	denseToID.push_back(id);
+
+	isOrderDirty = true;
+	return id;
+}
+
+void CollisionWorld::sortByLeftEdge()
+{
+	unsigned int count = getColliderCount();
+
+	//Colliders were added or removed, so start the order over with a full sort
+	if (isOrderDirty || sortedOrder.size() != count)
+	{
+		sortedOrder.resize(count);
+
+		for (unsigned int i = 0; i < count; i++)
+			sortedOrder[i] = i;
+
+		std::sort(sortedOrder.begin(), sortedOrder.end(), [this](unsigned int a, unsigned int b) { return minX[a] < minX[b]; });
+		isOrderDirty = false;
+		return;
+	}
+
+	//Otherwise the order from last frame is almost right already. Insertion sort is close to a single pass over an almost sorted list
+	for (unsigned int i = 1; i < count; i++)
+	{
+		unsigned int current = sortedOrder[i];
+		float currentMin = minX[current];
+		unsigned int j = i;
+
+		while (j > 0 && minX[sortedOrder[j - 1]] > currentMin)
+		{
+			sortedOrder[j] = sortedOrder[j - 1];
+			j--;
+		}
+
+		sortedOrder[j] = current;
+	}
+}
+
+bool CollisionWorld::testPair(unsigned int a, unsigned int b, CollisionContact& contact) const
+{
+	contact.colliderA = denseToID[a];
+	contact.colliderB = denseToID[b];
+
+	float dx = posX[b] - posX[a];
+	float dy = posY[b] - posY[a];
+
+	//Box against box. Push out along whichever axis overlaps the least
+	if (shape[a] == ColliderShape::Box && shape[b] == ColliderShape::Box)
+	{
+		float overlapX = halfWidth[a] + halfWidth[b] - fabsf(dx);
+		float overlapY = halfHeight[a] + halfHeight[b] - fabsf(dy);
+
+		if (overlapX <= 0.0f || overlapY <= 0.0f)
+			return false;
+
+		if (overlapX < overlapY)
+		{
+			contact.normalX = signOf(dx);
+			contact.normalY = 0.0f;
+			contact.depth = overlapX;
+		}
+		else
+		{
+			contact.normalX = 0.0f;
+			contact.normalY = signOf(dy);
+			contact.depth = overlapY;
+		}
+
+		return true;
+	}
+
+	//Circle against circle. Push out along the line between the centers
+	if (shape[a] == ColliderShape::Circle && shape[b] == ColliderShape::Circle)
+	{
+		float radii = halfWidth[a] + halfWidth[b];
+		float distanceSquared = dx * dx + dy * dy;
+
+		if (distanceSquared >= radii * radii)
+			return false;
+
+		float distance = sqrtf(distanceSquared);
+
+		if (distance > MIN_DISTANCE)
+		{
+			contact.normalX = dx / distance;
+			contact.normalY = dy / distance;
+		}
+		else
+		{
+			//Exactly on top of each other, so just pick a direction
+			contact.normalX = 0.0f;
+			contact.normalY = 1.0f;
+		}
+
+		contact.depth = radii - distance;
+		return true;
+	}
+
+	//Box against circle
+	if (shape[a] == ColliderShape::Box)
+		return testBoxCircle(posX[a], posY[a], halfWidth[a], halfHeight[a], posX[b], posY[b], halfWidth[b], contact.normalX, contact.normalY, contact.depth);
+
+	//Circle against box. Test it the other way around then flip the normal so it still points from A to B
+	if (!testBoxCircle(posX[b], posY[b], halfWidth[b], halfHeight[b], posX[a], posY[a], halfWidth[a], contact.normalX, contact.normalY, contact.depth))
+		return false;
+
+	contact.normalX = -contact.normalX;
+	contact.normalY = -contact.normalY;
+	return true;
+}
@@ -0,0 +1,219 @@
+/*
+============================================================
+	Collision World:
+		- A lightweight replacement for the Chipmunk physics world when all you need is "what is touching what"
+			> Supports boxes (axis aligned, no rotation) and circles
+			> Every collider attribute is stored in its own array ("structure of arrays") so the broadphase loops run straight through memory
+			> Uses sweep and prune for the broadphase: colliders are kept sorted along the x axis, so only neighbours on that axis are ever compared. The order barely changes from frame to frame so re-sorting is almost free
+		- Layers and masks decide what can collide with what
+			> Every collider is on one or more layers (bits) and has a mask of the layers it wants to touch. Two colliders are only tested if each one's layer is in the other one's mask
+			> Ex: players on layer 1 with mask 2, enemies on layer 2 with mask 1 -> players hit enemies, but players never test against other players
+		- Call findContacts() once per frame after moving everything. It returns every touching pair at once
+			> Optionally call resolveContacts() to push overlapping colliders apart. Static colliders never move
+		- This class doesn't need a window or a scene. Store a Node* in the user data and copy the positions over yourself
+			> HelloWorld::createScene(false) makes a scene without the Chipmunk world, so nothing is paid for physics that isn't used
+			> Use CollisionBenchmark to compare this against the Chipmunk world with the same bodies
+
+	Usage:
+		- You are free to use this class for the case studies and for GDW
+		- You are free to edit / overwrite any or all of this class
+			> It is simply here to make your life easier
+		- You must leave this comment block at the top of the header
+============================================================
+*/
+
+#ifndef COLLISIONWORLD_H
+#define COLLISIONWORLD_H
+
+//Core Libraries
+#include <cstdint>
+#include <vector>
+
+//Useful shorthands
+typedef unsigned int ColliderID; //A handle to a collider. Stays the same even when other colliders are removed
+#define INVALID_COLLIDER 0xFFFFFFFF //Returned when a collider couldn't be found
+
+/*
+	Collider Shape Enum
+	- The shapes the collision world understands
+*/
+enum class ColliderShape : uint8_t
+{
+	Box, //An axis aligned box, stored as its half width and half height
+	Circle //A circle, stored as its radius
+};
+
+/*
+	Collision Contact Struct
+	- A single pair of colliders that are touching
+*/
+struct CollisionContact
+{
+	ColliderID colliderA, colliderB; //The two colliders that are touching
+	float normalX, normalY; //The direction to push B to get it away from A. Always length 1
+	float depth; //How far the two colliders overlap along the normal, in pixels
+};
+
+
+
+/*
+	Collision World Class:
+	> Setters
+		- Set a collider's position, size, layer and user data
+	> Getters
+		- Get a collider's position and user data
+		- Get the contacts from the last update
+	> Methods
+		- Add / remove colliders
+		- Find contacts
+		- Resolve contacts
+*/
+class CollisionWorld
+{
+public:
+	//--- Constructors and Destructor ---//
+	CollisionWorld();
+	~CollisionWorld();
+
+
+
+	//--- Setters ---//
+	/*
+		@param ID -> The collider to move
+		@param X -> The new x of the center, in pixels
+		@param Y -> The new y of the center, in pixels
+	*/
+	void setPosition(ColliderID id, float x, float y);
+
+	/*
+		@param ID -> The collider to resize
+		@param HalfWidth -> Half of the width for boxes, or the radius for circles
+		@param HalfHeight -> Half of the height for boxes. Ignored for circles
+	*/
+	void setSize(ColliderID id, float halfWidth, float halfHeight);
+
+	/*
+		@param ID -> The collider to change
+		@param Layer -> The layer bits the collider is on
+		@param Mask -> The layer bits the collider can touch
+	*/
+	void setLayer(ColliderID id, uint32_t layer, uint32_t mask);
+
+	/*
+		@param ID -> The collider to change
+		@param UserData -> Anything you want to attach to the collider. Ex: the Node it belongs to
+	*/
+	void setUserData(ColliderID id, void* userData);
+
+
+
+	//--- Getters ---//
+	/*
+		@param ID -> The collider to check
+		@return Returns -> True if the collider exists
+	*/
+	bool isValid(ColliderID id) const;
+
+	/*
+		@param ID -> The collider to check
+		@param X -> Filled in with the x of the center
+		@param Y -> Filled in with the y of the center
+	*/
+	void getPosition(ColliderID id, float& x, float& y) const;
+
+	/*
+		@param ID -> The collider to check
+		@return Returns -> The user data attached to the collider, or nullptr if there is none
+	*/
+	void* getUserData(ColliderID id) const;
+
+	/*
+		@return Returns -> The number of colliders in the world
+	*/
+	unsigned int getColliderCount() const;
+
+	/*
+		@return Returns -> Every contact found by the last findContacts()
+	*/
+	const std::vector<CollisionContact>& getContacts() const;
+
+
+
+	//--- Methods ---//
+	/*
+		Add a box to the world
+
+		@param X, Y -> The center of the box, in pixels
+		@param Width, Height -> The size of the box, in pixels
+		@param Layer -> The layer bits the box is on. Defaulted to layer 1
+		@param Mask -> The layer bits the box can touch. Defaulted to every layer
+		@param IsStatic -> True if the box never moves. Static colliders are never tested against each other and are never pushed by resolveContacts()
+		@return Returns -> The handle to the new collider
+	*/
+	ColliderID addBox(float x, float y, float width, float height, uint32_t layer = 1, uint32_t mask = 0xFFFFFFFF, bool isStatic = false);
+
+	/*
+		Add a circle to the world
+
+		@param X, Y -> The center of the circle, in pixels
+		@param Radius -> The radius of the circle, in pixels
+		@param Layer -> The layer bits the circle is on. Defaulted to layer 1
+		@param Mask -> The layer bits the circle can touch. Defaulted to every layer
+		@param IsStatic -> True if the circle never moves
+		@return Returns -> The handle to the new collider
+	*/
+	ColliderID addCircle(float x, float y, float radius, uint32_t layer = 1, uint32_t mask = 0xFFFFFFFF, bool isStatic = false);
+
+	/*
+		Remove a collider. Its handle becomes invalid and may be reused by a later add
+
+		@param ID -> The collider to remove
+	*/
+	void removeCollider(ColliderID id);
+
+	/*
+		Remove every collider
+	*/
+	void clear();
+
+	/*
+		Find every pair of colliders that are touching. Call this once per frame after moving everything
+
+		@return Returns -> Every contact. The same list as getContacts()
+	*/
+	const std::vector<CollisionContact>& findContacts();
+
+	/*
+		Push the colliders in the last contact list apart. Two moving colliders are each pushed half of the way, a moving collider touching a static one is pushed all of the way
+
+		@param Iterations -> How many times to go over the contacts. More iterations settle piles of colliders better. Defaulted to 1
+	*/
+	void resolveContacts(unsigned int iterations = 1);
+
+private:
+	//--- Private Data ---//
+	//The collider attributes, one entry per collider. Removing a collider moves the last one into its place so the arrays never have gaps
+	std::vector<float> posX, posY; //The centers
+	std::vector<float> halfWidth, halfHeight; //Half of the size. Both are the radius for circles
+	std::vector<ColliderShape> shape; //Box or circle
+	std::vector<uint32_t> layer, mask; //Which layers each collider is on and can touch
+	std::vector<uint8_t> isStatic; //1 if the collider never moves
+	std::vector<void*> userData; //Whatever was attached with setUserData()
+	std::vector<ColliderID> denseToID; //The handle of each collider in the arrays
+
+	std::vector<unsigned int> idToDense; //Where each handle's collider is in the arrays. INVALID_COLLIDER if the handle is free
+	std::vector<ColliderID> freeIDs; //Handles that were removed and can be reused
+
+	std::vector<float> minX, maxX; //The left and right edge of each collider. Rebuilt every findContacts()
+	std::vector<unsigned int> sortedOrder; //The colliders sorted by their left edge. Kept between frames since it barely changes
+	bool isOrderDirty; //True if colliders were added or removed since the last sort
+
+	std::vector<CollisionContact> contacts; //The contacts from the last findContacts()
+
+	//--- Utility Functions ---//
+	ColliderID addCollider(ColliderShape colliderShape, float x, float y, float halfW, float halfH, uint32_t colliderLayer, uint32_t colliderMask, bool colliderIsStatic); //Adds a collider of any shape
+	void sortByLeftEdge(); //Updates the sweep and prune order
+	bool testPair(unsigned int a, unsigned int b, CollisionContact& contact) const; //The narrowphase. Fills in the contact and returns true if the two colliders are touching
+};
+
+#endif
@@ -0,0 +1,375 @@
+#include "ComboRecognizer.h"
+
+//Core Libraries
+#include <algorithm>
+
+//--- Static Variables ---//
+ComboRecognizer* ComboRecognizer::inst = nullptr;
+
+//--- Constants ---//
+static const unsigned int NEVER = 0xFFFFFFFF; //Used as the frame number for things that haven't happened yet
+
+
+
+//--- Combo Input ---//
+ComboInput::ComboInput(KeyCode key)
+{
+	isMouseButton = false;
+	code = (int)key;
+}
+
+ComboInput::ComboInput(MouseButton button)
+{
+	isMouseButton = true;
+	code = (int)button;
+}
+
+bool ComboInput::operator==(const ComboInput& other) const
+{
+	return isMouseButton == other.isMouseButton && code == other.code;
+}
+
+
+
+//--- Combo Step ---//
+ComboStep::ComboStep(KeyCode key, unsigned int _maxFrames)
+{
+	inputs.push_back(ComboInput(key));
+	maxFrames = _maxFrames;
+}
+
+ComboStep::ComboStep(MouseButton button, unsigned int _maxFrames)
+{
+	inputs.push_back(ComboInput(button));
+	maxFrames = _maxFrames;
+}
+
+ComboStep::ComboStep(std::initializer_list<ComboInput> chord, unsigned int _maxFrames)
+{
+	inputs.assign(chord.begin(), chord.end());
+	maxFrames = _maxFrames;
+}
+
+
+
+//--- Constructor and Destructor ---//
+ComboRecognizer::ComboRecognizer()
+{
+	chordWindow = 3;
+	totalTime = 0.0f;
+
+	//Start with an empty state machine
+	compile();
+}
+
+ComboRecognizer::~ComboRecognizer()
+{
+	//Delete the singleton instance
+	if (inst)
+		delete inst;
+
+	//Clean up the pointer
+	inst = nullptr;
+}
+
+
+
+//--- Setters ---//
+void ComboRecognizer::setChordWindow(unsigned int frames)
+{
+	chordWindow = frames;
+}
+
+
+
+//--- Getters ---//
+bool ComboRecognizer::getCombo(const std::string& name) const
+{
+	for (unsigned int i = 0; i < events.size(); i++)
+	{
+		if (events[i].name == name)
+			return true;
+	}
+
+	return false;
+}
+
+const std::vector<ComboEvent>& ComboRecognizer::getEvents() const
+{
+	return events;
+}
+
+
+
+//--- Methods ---//
+int ComboRecognizer::addCombo(const std::string& name, const std::vector<ComboStep>& steps, const std::function<void(const ComboEvent& event)>& callback)
+{
+	if (steps.empty())
+		return -1;
+
+	Combo combo;
+	combo.name = name;
+	combo.steps = steps;
+	combo.callback = callback;
+	combos.push_back(combo);
+
+	compile();
+
+	//Too many different inputs to fit in the bit masks, so take it back out
+	if (watchedInputs.size() > COMBO_MAX_INPUTS)
+	{
+		combos.pop_back();
+		compile();
+		return -1;
+	}
+
+	return (int)combos.size() - 1;
+}
+
+void ComboRecognizer::clear()
+{
+	combos.clear();
+	events.clear();
+	compile();
+}
+
+void ComboRecognizer::update(float deltaTime)
+{
+	totalTime += deltaTime;
+	events.clear();
+
+	//Nothing to do if there are no combos
+	if (states.size() <= 1)
+		return;
+
+	unsigned int frame = INPUTS->getFrameNumber();
+
+	//Read every watched input once. Each one becomes a bit in the masks
+	uint64_t pressedMask = 0; //Inputs pressed this frame
+	uint64_t downMask = 0; //Inputs that are down
+	uint64_t recentMask = 0; //Inputs pressed recently enough to be part of a chord
+
+	for (unsigned int i = 0; i < watchedInputs.size(); i++)
+	{
+		const ComboInput& input = watchedInputs[i];
+		uint64_t bit = (uint64_t)1 << i;
+		bool isPressed = input.isMouseButton ? INPUTS->getMouseButtonPress((MouseButton)input.code) : INPUTS->getKeyPress((KeyCode)input.code);
+		bool isDown = input.isMouseButton ? INPUTS->getMouseButton((MouseButton)input.code) : INPUTS->getKey((KeyCode)input.code);
+
+		if (isPressed)
+		{
+			pressedMask |= bit;
+			lastPressFrames[i] = frame;
+		}
+
+		if (isDown)
+			downMask |= bit;
+
+		if (lastPressFrames[i] != NEVER && frame - lastPressFrames[i] <= chordWindow)
+			recentMask |= bit;
+	}
+
+	//Check every combo in progress. Drop the ones that waited too long, and find the ones that take their next step
+	nextActiveStates.clear();
+	pendingEntries.clear();
+
+	for (unsigned int i = 0; i < activeStates.size(); i++)
+	{
+		unsigned int stateIndex = activeStates[i];
+		ComboState& state = states[stateIndex];
+		unsigned int elapsedFrames = frame - state.lastStepFrame;
+
+		if (elapsedFrames > state.maxFrames)
+		{
+			state.isActive = false;
+			continue;
+		}
+
+		nextActiveStates.push_back(stateIndex);
+
+		for (unsigned int j = 0; j < state.edges.size(); j++)
+		{
+			const ComboEdge& edge = state.edges[j];
+
+			if (elapsedFrames <= edge.maxFrames && isEdgeTaken(edge, pressedMask, downMask, recentMask))
+				pendingEntries.push_back(std::make_pair(edge.target, state.startFrame));
+		}
+	}
+
+	//Any combo can start on any frame. The first step has no time limit
+	const ComboState& root = states[0];
+
+	for (unsigned int i = 0; i < root.edges.size(); i++)
+	{
+		if (isEdgeTaken(root.edges[i], pressedMask, downMask, recentMask))
+			pendingEntries.push_back(std::make_pair(root.edges[i].target, frame));
+	}
+
+	//Take the steps
+	activeStates.swap(nextActiveStates);
+
+	for (unsigned int i = 0; i < pendingEntries.size(); i++)
+		enterState(pendingEntries[i].first, frame, pendingEntries[i].second);
+
+	//Report the combos in the order they were added, then run their callbacks
+	std::sort(events.begin(), events.end(), [](const ComboEvent& a, const ComboEvent& b) { return a.comboID < b.comboID; });
+
+	for (unsigned int i = 0; i < events.size(); i++)
+	{
+		const Combo& combo = combos[events[i].comboID];
+
+		if (combo.callback)
+			combo.callback(events[i]);
+	}
+}
+
+
+
+//--- Singleton Instance ---//
+ComboRecognizer* ComboRecognizer::getInstance()
+{
+	//Generate the singleton if it hasn't been created yet
+	if (!inst)
+		inst = new ComboRecognizer();
+
+	//Return the singleton
+	return inst;
+}
+
+
+
+//--- Utility Functions ---//
+void ComboRecognizer::compile()
+{
+	watchedInputs.clear();
+	chordMasks.clear();
+	states.clear();
+	activeStates.clear();
+
+	//State 0 is the root, where every combo starts
+	ComboState root;
+	root.maxFrames = 0;
+	root.isActive = false;
+	root.lastStepFrame = NEVER;
+	root.startFrame = NEVER;
+	states.push_back(root);
+
+	//Add each combo to the tree one step at a time. Steps that match an existing branch share it
+	for (unsigned int i = 0; i < combos.size(); i++)
+	{
+		unsigned int current = 0;
+		uint64_t previousMask = 0;
+
+		for (unsigned int j = 0; j < combos[i].steps.size(); j++)
+		{
+			const ComboStep& step = combos[i].steps[j];
+
+			//Turn the step's inputs into a bit mask, then find or add the chord
+			uint64_t mask = 0;
+
+			for (unsigned int k = 0; k < step.inputs.size(); k++)
+			{
+				unsigned int inputIndex = getInputIndex(step.inputs[k]);
+
+				if (inputIndex < COMBO_MAX_INPUTS)
+					mask |= (uint64_t)1 << inputIndex;
+			}
+
+			unsigned int chord = (unsigned int)(std::find(chordMasks.begin(), chordMasks.end(), mask) - chordMasks.begin());
+
+			if (chord == chordMasks.size())
+				chordMasks.push_back(mask);
+
+			//The first step can happen any time, so it has no frame limit
+			unsigned int maxFrames = (j == 0) ? 0 : step.maxFrames;
+
+			//Follow the matching branch, or make a new one
+			unsigned int next = 0;
+
+			for (unsigned int k = 0; k < states[current].edges.size(); k++)
+			{
+				const ComboEdge& edge = states[current].edges[k];
+
+				if (edge.chord == chord && edge.maxFrames == maxFrames)
+				{
+					next = edge.target;
+					break;
+				}
+			}
+
+			if (next == 0)
+			{
+				next = (unsigned int)states.size();
+				states.push_back(root);
+				//Inputs carried over from the step before were pressed earlier, so only the new ones are held to the chord window
+				//If the step is the same as the one before (ex: tapping down twice), every input has to be pressed again
+				uint64_t freshMask = mask & ~previousMask;
+
+				if (freshMask == 0)
+					freshMask = mask;
+
+				states[current].edges.push_back({ chord, freshMask, maxFrames, next });
+				states[current].maxFrames = std::max(states[current].maxFrames, maxFrames);
+			}
+
+			current = next;
+			previousMask = mask;
+		}
+
+		states[current].completedCombos.push_back(i);
+	}
+
+	//Reset the per frame data to match
+	lastPressFrames.assign(watchedInputs.size(), NEVER);
+	nextActiveStates.reserve(states.size());
+	activeStates.reserve(states.size());
+}
+
+unsigned int ComboRecognizer::getInputIndex(const ComboInput& input)
+{
+	for (unsigned int i = 0; i < watchedInputs.size(); i++)
+	{
+		if (watchedInputs[i] == input)
+			return i;
+	}
+
+	watchedInputs.push_back(input);
+	return (unsigned int)watchedInputs.size() - 1;
+}
+
+void ComboRecognizer::enterState(unsigned int stateIndex, unsigned int frame, unsigned int startFrame)
+{
+	ComboState& state = states[stateIndex];
+
+	//Two combos in progress reached the same state on the same frame. Keep the one that started later since it is the tighter match, and only report it once
+	if (state.lastStepFrame == frame)
+	{
+		state.startFrame = std::max(state.startFrame, startFrame);
+		return;
+	}
+
+	state.lastStepFrame = frame;
+	state.startFrame = startFrame;
+
+	//Keep track of the state if it can go any further
+	if (!state.isActive && !state.edges.empty())
+	{
+		state.isActive = true;
+		activeStates.push_back(stateIndex);
+	}
+
+	//Report every combo that finishes here
+	for (unsigned int i = 0; i < state.completedCombos.size(); i++)
+	{
+		unsigned int comboID = state.completedCombos[i];
+		ComboEvent event = { comboID, combos[comboID].name, startFrame, frame, totalTime };
+		events.push_back(event);
+	}
+}
+
+bool ComboRecognizer::isEdgeTaken(const ComboEdge& edge, uint64_t pressedMask, uint64_t downMask, uint64_t recentMask) const
+{
+	//A chord happens when one of its new inputs was just pressed, the new inputs were pressed close enough together, and every input is down
+	uint64_t chord = chordMasks[edge.chord];
+	return (edge.freshMask & pressedMask) != 0 && (edge.freshMask & recentMask) == edge.freshMask && (chord & downMask) == chord;
+}
@@ -0,0 +1,246 @@
+/*
+============================================================
+	Combo Recognizer:
+		- Detects fighting game style combos, sequences and chords without any timers in your own code
+			> A combo is a list of steps. Each step is one input, or a chord of inputs pressed together (ex: down + right for down-forward)
+			> Each step has to come within a certain number of frames of the step before it
+			> Ex: COMBOS->addCombo("Hadouken", { KeyCode::KEY_DOWN_ARROW, { KeyCode::KEY_DOWN_ARROW, KeyCode::KEY_RIGHT_ARROW }, { KeyCode::KEY_RIGHT_ARROW, KeyCode::KEY_Z } });
+		- Every combo is compiled into a single tree of steps (a state machine). Combos that start the same way share the same branches
+			> Each frame, the inputs are read once and every combo in progress is moved forward in a single pass, no matter how many combos there are
+		- Call COMBOS->update(deltaTime) once per frame from your scene's update(), BEFORE INPUTS->clearForNextFrame()
+			> Then check getCombo("Hadouken"), look through getEvents(), or pass a callback to addCombo()
+		- Every recognized combo carries the input frame number it started and finished on, so the timing is exact to the frame
+
+	Usage:
+		- You are free to use this class for the case studies and for GDW
+		- You are free to edit / overwrite any or all of this class
+			> It is simply here to make your life easier
+		- You must leave this comment block at the top of the header
+
+	Note:
+		- This class uses the Singleton design pattern
+			> Do not ever make more than one instance of this class in its current form
+			> You don't ever have to call the constructor for this class. Simply start using it and it will build itself
+			> There is a macro "COMBOS->" that provides a shortcut for getting the singleton instance
+		- Up to 64 different keys / buttons can be used across all of the combos
+============================================================
+*/
+
+#ifndef COMBORECOGNIZER_H
+#define COMBORECOGNIZER_H
+
+//Core Libraries
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+
+//3rd Party Libraries
+#include "cocos2d.h"
+
+//Our Classes
+#include "InputHandler.h"
+
+//Namespaces
+using namespace cocos2d;
+
+//Useful shorthands
+#define COMBO_DEFAULT_STEP_FRAMES 12 //How many frames a step can come after the previous one by default. 12 frames is 0.2 seconds at 60 fps
+#define COMBO_MAX_INPUTS 64 //The most different keys / buttons every combo put together can use
+
+/*
+	Combo Input Struct
+	- A single key or mouse button. Can be made straight from a KeyCode or MouseButton
+*/
+struct ComboInput
+{
+	bool isMouseButton; //True for a mouse button, false for a key
+	int code; //The KeyCode or MouseButton as a number
+
+	ComboInput(KeyCode key); //Ex: ComboInput(KeyCode::KEY_Z)
+	ComboInput(MouseButton button); //Ex: ComboInput(MouseButton::BUTTON_LEFT)
+
+	bool operator==(const ComboInput& other) const;
+};
+
+/*
+	Combo Step Struct
+	- One step of a combo: a single input or a chord of inputs that all have to be down together
+	- The step happens on the frame the last of its inputs is pressed, as long as the others are still held
+*/
+struct ComboStep
+{
+	std::vector<ComboInput> inputs; //Every input that has to be down
+	unsigned int maxFrames; //The most frames this step can come after the previous one. Ignored for the first step
+
+	ComboStep(KeyCode key, unsigned int maxFrames = COMBO_DEFAULT_STEP_FRAMES); //A single key
+	ComboStep(MouseButton button, unsigned int maxFrames = COMBO_DEFAULT_STEP_FRAMES); //A single mouse button
+	ComboStep(std::initializer_list<ComboInput> chord, unsigned int maxFrames = COMBO_DEFAULT_STEP_FRAMES); //A chord. Ex: { KeyCode::KEY_DOWN_ARROW, KeyCode::KEY_RIGHT_ARROW }
+};
+
+/*
+	Combo Event Struct
+	- A combo that was just recognized
+*/
+struct ComboEvent
+{
+	unsigned int comboID; //The ID returned by addCombo()
+	std::string name; //The name given to addCombo()
+	unsigned int startFrame; //The input frame the first step happened on. See InputHandler::getFrameNumber()
+	unsigned int endFrame; //The input frame the last step happened on. This is the frame the combo was recognized
+	float time; //The time the combo was recognized, in seconds since the recognizer started
+};
+
+
+
+/*
+	Combo Recognizer Class:
+	> Setters
+		- Set the chord window
+	> Getters
+		- Get if a combo was recognized this frame
+		- Get every combo recognized this frame
+	> Methods
+		- Add / clear combos
+		- Update (call once per frame)
+*/
+class ComboRecognizer
+{
+protected:
+	//--- Constructor ---//
+	ComboRecognizer(); //The constructor is protected so only one instance of this class can ever exist. This is called the singleton pattern.
+
+public:
+	//--- Destructor ---//
+	~ComboRecognizer();
+
+
+
+	//--- Setters ---//
+	/*
+		Set how close together the inputs of a chord have to be pressed. Nobody presses two keys on the exact same frame
+
+		@param Frames -> The most frames between the first and last input of a chord. Defaulted to 3. Inputs still held from the step before (ex: down in down, down + right) only have to stay down
+	*/
+	void setChordWindow(unsigned int frames);
+
+
+
+	//--- Getters ---//
+	/*
+		@param Name -> The name given to addCombo()
+		@return Returns -> True if the combo was recognized this EXACT frame
+	*/
+	bool getCombo(const std::string& name) const;
+
+	/*
+		@return Returns -> Every combo recognized this frame, in the order they were added
+	*/
+	const std::vector<ComboEvent>& getEvents() const;
+
+
+
+	//--- Methods ---//
+	/*
+		Add a combo. The state machine is rebuilt right away, so any combos in progress are forgotten. Add every combo at the start of the scene
+
+		@param Name -> The name used to check for it. Ex: "Hadouken"
+		@param Steps -> The steps in order. Ex: { KeyCode::KEY_DOWN_ARROW, { KeyCode::KEY_DOWN_ARROW, KeyCode::KEY_RIGHT_ARROW }, { KeyCode::KEY_RIGHT_ARROW, KeyCode::KEY_Z } }
+		@param Callback (optional) -> Run on the frame the combo is recognized
+		@return Returns -> The ID of the combo, or -1 if it has no steps or uses too many different inputs
+	*/
+	int addCombo(const std::string& name, const std::vector<ComboStep>& steps, const std::function<void(const ComboEvent& event)>& callback = nullptr);
+
+	/*
+		Remove every combo and forget any combos in progress
+	*/
+	void clear();
+
+	/*
+		Read this frame's inputs and move every combo in progress forward. Call this once per frame BEFORE INPUTS->clearForNextFrame()
+
+		@param DeltaTime -> The time since the last frame in seconds
+	*/
+	void update(float deltaTime);
+
+
+
+	//--- Singleton Instance ---//
+	/*
+		Get the instance of the singleton. You shouldn't ever need to call this directly since the macro (COMBOS->) automatically calls it
+
+		@return Returns -> The singleton instance of this class. This is the ONLY instance of this class so intrefacing HAS to be done through this instance.
+	*/
+	static ComboRecognizer* getInstance();
+
+private:
+	/*
+		Combo Struct
+		- A combo as it was added
+	*/
+	struct Combo
+	{
+		std::string name; //The name to check for
+		std::vector<ComboStep> steps; //The steps in order
+		std::function<void(const ComboEvent&)> callback; //Run when it is recognized
+	};
+
+	/*
+		Combo Edge Struct
+		- A branch from one state to the next, taken when its chord happens in time
+	*/
+	struct ComboEdge
+	{
+		unsigned int chord; //Which chord has to happen. An index into chordMasks
+		uint64_t freshMask; //The inputs in the chord that weren't part of the step before. Only these have to be pressed within the chord window
+		unsigned int maxFrames; //The most frames since the last step
+		unsigned int target; //The state this leads to
+	};
+
+	/*
+		Combo State Struct
+		- One node in the tree of steps. The root is "nothing pressed yet"
+	*/
+	struct ComboState
+	{
+		std::vector<ComboEdge> edges; //Where this state can go next
+		std::vector<unsigned int> completedCombos; //The combos that are finished when this state is reached
+		unsigned int maxFrames; //The longest any of the edges waits. Once this many frames pass without a step, the state is dropped
+
+		//Only used while the combo is in progress
+		bool isActive; //True if a combo in progress is at this state
+		unsigned int lastStepFrame; //The frame the step that led here happened
+		unsigned int startFrame; //The frame the first step happened
+	};
+
+	//--- Private Data ---//
+	std::vector<Combo> combos; //Every combo added
+	unsigned int chordWindow; //The most frames between the inputs of a chord
+	float totalTime; //Seconds since the recognizer started
+
+	//The compiled state machine
+	std::vector<ComboInput> watchedInputs; //Every input used by any combo. Only these are read each frame
+	std::vector<uint64_t> chordMasks; //Every different chord used by any combo, as a bit per watched input
+	std::vector<ComboState> states; //The tree of steps. State 0 is the root
+	std::vector<unsigned int> activeStates; //The states with a combo in progress
+
+	//Per frame data
+	std::vector<unsigned int> lastPressFrames; //The frame each watched input was last pressed
+	std::vector<unsigned int> nextActiveStates; //Used to build the new list of active states without allocating
+	std::vector<std::pair<unsigned int, unsigned int>> pendingEntries; //The states being moved into this frame and the start frame of each. Applied after every state has been checked so no combo takes two steps in one frame
+	std::vector<ComboEvent> events; //The combos recognized this frame
+
+	//--- Singleton Instance ---//
+	static ComboRecognizer* inst; //The singleton instance of this class. Ie: the only instance that can ever exist
+
+	//--- Utility Functions ---//
+	void compile(); //Builds the state machine from every combo
+	unsigned int getInputIndex(const ComboInput& input); //Finds or adds a watched input
+	void enterState(unsigned int state, unsigned int frame, unsigned int startFrame); //Moves a combo in progress into a state, recognizing any combos that finish there
+	bool isEdgeTaken(const ComboEdge& edge, uint64_t pressedMask, uint64_t downMask, uint64_t recentMask) const; //True if the edge's chord happened this frame
+};
+
+#define COMBOS ComboRecognizer::getInstance() //Macro to make using the class easier. Automatically gets the singleton instance for you
+
+#endif
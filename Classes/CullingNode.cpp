@@ -0,0 +1,444 @@
+#include "CullingNode.h"
+#include "DisplayHandler.h"
+
+//Core Libraries
+#include <climits>
+#include <algorithm>
+#include <sstream>
+
+//--- Static Variables ---//
+CullingStats CullingNode::currentStats;
+CullingStats CullingNode::lastStats;
+bool CullingNode::isTrackingStats = false;
+
+//--- Constants ---//
+static const std::string OVERLAY_UPDATE_KEY = "CullingNode_Overlay"; //The scheduler key for refreshing the stats overlay
+
+
+
+//--- Culling Stats ---//
+CullingStats::CullingStats()
+{
+	visitedNodes = 0;
+	culledNodes = 0;
+	culledSubtrees = 0;
+	boundsUpdates = 0;
+	drawCalls = 0;
+	drawnVertices = 0;
+}
+
+CullingNode::CulledChild::CulledChild()
+{
+	childCount = 0;
+	nodeCount = 0;
+	ownNodeCount = 0;
+	missedFlags = 0;
+	isDirty = true;
+}
+
+
+
+//--- Creation ---//
+CullingNode* CullingNode::create()
+{
+	//Same pattern as CREATE_FUNC
+	CullingNode* node = new (std::nothrow) CullingNode();
+	if (node && node->init())
+	{
+		node->autorelease();
+		return node;
+	}
+
+	CC_SAFE_DELETE(node);
+	return nullptr;
+}
+
+Node* CullingNode::createOverlay()
+{
+	//Put the label in the top right so it doesn't cover the other overlays
+	Label* overlay = Label::createWithSystemFont("", "Arial", 10.0f);
+	overlay->setAnchorPoint(Vec2(1.0f, 1.0f));
+	overlay->setPosition(Vec2(DISPLAY->getWindowSize().width - 4.0f, DISPLAY->getWindowSize().height - 4.0f));
+	overlay->setAlignment(TextHAlignment::RIGHT);
+	overlay->setTextColor(Color4B::WHITE);
+
+	//Rebuild the text twice a second
+	overlay->schedule([overlay](float deltaTime)
+	{
+		std::stringstream text;
+		text << "Visited " << lastStats.visitedNodes << "  Culled " << lastStats.culledNodes << " (" << lastStats.culledSubtrees << " subtrees)\n";
+		text << "Bounds updates " << lastStats.boundsUpdates << "\n";
+		text << "Draw calls " << lastStats.drawCalls << "  Vertices " << lastStats.drawnVertices;
+
+		overlay->setString(text.str());
+	}, 0.5f, OVERLAY_UPDATE_KEY);
+
+	return overlay;
+}
+
+
+
+//--- Constructor and Destructor ---//
+CullingNode::CullingNode()
+{
+	padding = 0.0f;
+	lastPollFrame = UINT_MAX;
+	hasChangedSinceTaken = false;
+}
+
+CullingNode::~CullingNode()
+{
+}
+
+bool CullingNode::init()
+{
+	if (!Node::init())
+		return false;
+
+	//Save the counts once every frame has been drawn, then start counting again for the next one
+	//The renderer's counts are only finished at this point, so this is the only place the draw calls can be read
+	if (!isTrackingStats)
+	{
+		Director::getInstance()->getEventDispatcher()->addCustomEventListener(Director::EVENT_AFTER_DRAW, [](EventCustom* event)
+		{
+			Renderer* renderer = Director::getInstance()->getRenderer();
+			currentStats.drawCalls = (unsigned int)renderer->getDrawnBatches();
+			currentStats.drawnVertices = (unsigned int)renderer->getDrawnVertices();
+
+			lastStats = currentStats;
+			currentStats = CullingStats();
+		});
+
+		isTrackingStats = true;
+	}
+
+	return true;
+}
+
+
+
+//--- Setters ---//
+void CullingNode::setPadding(float _padding)
+{
+	padding = _padding;
+}
+
+void CullingNode::markDirty(Node* node)
+{
+	//Go up the tree and mark the branch holding the node in every culling node along the way
+	for (Node* child = node; child && child->getParent(); child = child->getParent())
+	{
+		CullingNode* cullingNode = dynamic_cast<CullingNode*>(child->getParent());
+
+		if (!cullingNode)
+			continue;
+
+		auto culledChild = cullingNode->culledChildren.find(child);
+
+		if (culledChild != cullingNode->culledChildren.end())
+			culledChild->second.isDirty = true;
+	}
+}
+
+
+
+//--- Getters ---//
+float CullingNode::getPadding() const
+{
+	return padding;
+}
+
+const CullingStats& CullingNode::getStats()
+{
+	return lastStats;
+}
+
+
+
+//--- Methods ---//
+void CullingNode::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags)
+{
+	//Same as Node::visit(), except children that are off-screen are skipped. A culling node doesn't draw anything itself
+	if (!_visible)
+		return;
+
+	uint32_t flags = processParentFlags(parentTransform, parentFlags);
+	pollBranches();
+
+	_director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+	_director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+
+	Rect viewBounds = getViewBounds();
+	sortAllChildren();
+
+	for (Node* child : _children)
+	{
+		CulledChild& culledChild = culledChildren[child];
+
+		if (!child->isVisible())
+			continue;
+
+		//A branch on screen is about to be visited anyway, so its nodes are checked for changes using the same dirty flags Cocos2D uses
+		if (viewBounds.intersectsRect(culledChild.bounds) && hasBranchChanged(child, culledChild))
+			updateChildBounds(child, culledChild);
+
+		//The whole branch is off-screen. Remember if the transform changed so the branch isn't drawn in the wrong place when it comes back
+		if (!viewBounds.intersectsRect(culledChild.bounds))
+		{
+			culledChild.missedFlags |= flags & FLAGS_DIRTY_MASK;
+			currentStats.culledNodes += culledChild.nodeCount;
+			currentStats.culledSubtrees++;
+			continue;
+		}
+
+		child->visit(renderer, _modelViewTransform, flags | culledChild.missedFlags);
+		culledChild.missedFlags = 0;
+
+		//Inner culling nodes count their own children
+		currentStats.visitedNodes += culledChild.ownNodeCount;
+	}
+
+	_director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+}
+
+void CullingNode::removeChild(Node* child, bool cleanup)
+{
+	culledChildren.erase(child);
+	Node::removeChild(child, cleanup);
+}
+
+void CullingNode::removeAllChildrenWithCleanup(bool cleanup)
+{
+	culledChildren.clear();
+	Node::removeAllChildrenWithCleanup(cleanup);
+}
+
+
+
+//--- Utility Functions ---//
+void CullingNode::pollBranches()
+{
+	//Only poll once a frame. An outer culling node polls this one before it is visited, so the visit doesn't do it again
+	unsigned int frame = _director->getTotalFrames();
+
+	if (frame == lastPollFrame)
+		return;
+
+	lastPollFrame = frame;
+
+	for (Node* child : _children)
+	{
+		auto found = culledChildren.find(child);
+
+		//A new child. Its bounds have never been worked out
+		if (found == culledChildren.end())
+			found = culledChildren.emplace(child, CulledChild()).first;
+
+		CulledChild& culledChild = found->second;
+
+		//Inner culling nodes keep track of their own children and say if any of their areas changed
+		for (CullingNode* cullingNode : culledChild.innerCullingNodes)
+		{
+			if (cullingNode->takeChanges())
+				culledChild.isDirty = true;
+		}
+
+		//Only the top of the branch and nodes running actions are checked here, since they are the ones that move without being visited
+		//Their flags are moved into the missed flags so a branch that stays off-screen doesn't look changed again next frame
+		for (ssize_t i = 0; i < culledChild.polledNodes.size(); i++)
+		{
+			Node* node = culledChild.polledNodes.at(i);
+			uint32_t dirtyFlags = getDirtyFlags(node);
+
+			if (dirtyFlags != 0)
+			{
+				culledChild.missedFlags |= dirtyFlags;
+				clearDirtyFlags(node);
+				culledChild.isDirty = true;
+			}
+
+			//The node was taken out of the branch. It is retained, so it is still safe to look at
+			if (i > 0 && !node->getParent())
+				culledChild.isDirty = true;
+		}
+
+		if (child->getChildrenCount() != culledChild.childCount)
+			culledChild.isDirty = true;
+
+		if (culledChild.isDirty)
+			updateChildBounds(child, culledChild);
+	}
+}
+
+bool CullingNode::takeChanges()
+{
+	pollBranches();
+
+	bool hasChanged = hasChangedSinceTaken;
+	hasChangedSinceTaken = false;
+	return hasChanged;
+}
+
+void CullingNode::updateChildBounds(Node* child, CulledChild& culledChild)
+{
+	//Work out the area of the whole branch. This is the only time the bounds of the nodes inside it are worked out
+	bool hasBounds = false;
+	culledChild.polledNodes.clear();
+	culledChild.innerCullingNodes.clear();
+	culledChild.childCount = child->getChildrenCount();
+	culledChild.nodeCount = 0;
+	culledChild.ownNodeCount = 0;
+	culledChild.isDirty = false;
+
+	addSubtreeBounds(child, Mat4::IDENTITY, culledChild, hasBounds);
+
+	//The bounds now match the polled nodes, so their flags are used up. They are still passed on to the branch through the missed flags
+	for (Node* node : culledChild.polledNodes)
+	{
+		culledChild.missedFlags |= getDirtyFlags(node);
+		clearDirtyFlags(node);
+	}
+
+	currentStats.boundsUpdates++;
+	hasChangedSinceTaken = true;
+}
+
+bool CullingNode::hasBranchChanged(Node* child, const CulledChild& culledChild)
+{
+	//Nodes being added or removed is caught by the count changing, since an added node only has its own flags set
+	unsigned int nodeCount = 0;
+	return hasSubtreeChanged(child, culledChild, nodeCount) || nodeCount != culledChild.ownNodeCount;
+}
+
+bool CullingNode::hasSubtreeChanged(Node* node, const CulledChild& culledChild, unsigned int& nodeCount)
+{
+	nodeCount++;
+
+	if (getDirtyFlags(node) != 0)
+		return true;
+
+	//An inner culling node checks its own children
+	for (CullingNode* cullingNode : culledChild.innerCullingNodes)
+	{
+		if (cullingNode == node)
+			return false;
+	}
+
+	for (Node* child : node->getChildren())
+	{
+		if (child->isVisible() && hasSubtreeChanged(child, culledChild, nodeCount))
+			return true;
+	}
+
+	return false;
+}
+
+void CullingNode::addSubtreeBounds(Node* node, const Mat4& parentToCulling, CulledChild& culledChild, bool& hasBounds)
+{
+	Mat4 nodeToCulling = parentToCulling * node->getNodeToParentTransform();
+	culledChild.ownNodeCount++;
+
+	//The top of the branch is always polled. So are nodes running actions, since they can move while the branch is off-screen
+	if (culledChild.polledNodes.empty() || node->getNumberOfRunningActions() > 0)
+		culledChild.polledNodes.pushBack(node);
+
+	//An inner culling node already has the areas of its own children saved, so those are reused instead of going through them again
+	CullingNode* cullingNode = dynamic_cast<CullingNode*>(node);
+
+	if (cullingNode)
+	{
+		cullingNode->takeChanges();
+		cullingNode->addSavedBounds(nodeToCulling, culledChild.bounds, hasBounds, culledChild.nodeCount);
+		culledChild.innerCullingNodes.pushBack(cullingNode);
+		return;
+	}
+
+	//Nodes without a size still count as a point so empty parents don't get lost
+	Size size = node->getContentSize();
+	Rect nodeBounds = RectApplyTransform(Rect(0.0f, 0.0f, size.width, size.height), nodeToCulling);
+
+	if (hasBounds)
+		culledChild.bounds.merge(nodeBounds);
+	else
+		culledChild.bounds = nodeBounds;
+
+	hasBounds = true;
+	culledChild.nodeCount++;
+
+	//Hidden nodes aren't drawn, so they don't add to the area
+	for (Node* child : node->getChildren())
+	{
+		if (child->isVisible())
+			addSubtreeBounds(child, nodeToCulling, culledChild, hasBounds);
+	}
+}
+
+void CullingNode::addSavedBounds(const Mat4& nodeToParent, Rect& bounds, bool& hasBounds, unsigned int& nodeCount) const
+{
+	Size size = getContentSize();
+	Rect nodeBounds = RectApplyTransform(Rect(0.0f, 0.0f, size.width, size.height), nodeToParent);
+
+	if (hasBounds)
+		bounds.merge(nodeBounds);
+	else
+		bounds = nodeBounds;
+
+	hasBounds = true;
+	nodeCount++;
+
+	for (auto& culledChild : culledChildren)
+	{
+		bounds.merge(RectApplyTransform(culledChild.second.bounds, nodeToParent));
+		nodeCount += culledChild.second.nodeCount;
+	}
+}
+
+uint32_t CullingNode::getDirtyFlags(Node* node)
+{
+	//Node keeps these flags protected. A pointer to them made through CullingNode is allowed to read them on any node
+	static bool Node::* const transformUpdated = &CullingNode::_transformUpdated;
+	static bool Node::* const contentSizeDirty = &CullingNode::_contentSizeDirty;
+
+	return ((node->*transformUpdated) ? FLAGS_TRANSFORM_DIRTY : 0) | ((node->*contentSizeDirty) ? FLAGS_CONTENT_SIZE_DIRTY : 0);
+}
+
+void CullingNode::clearDirtyFlags(Node* node)
+{
+	static bool Node::* const transformUpdated = &CullingNode::_transformUpdated;
+	static bool Node::* const contentSizeDirty = &CullingNode::_contentSizeDirty;
+
+	node->*transformUpdated = false;
+	node->*contentSizeDirty = false;
+}
+
+Rect CullingNode::getViewBounds() const
+{
+	//The camera is centered on the view, which is the size of the window
+	const Camera* camera = Camera::getVisitingCamera();
+	Size windowSize = DISPLAY->getWindowSize();
+	Vec2 cameraPosition = camera ? camera->getPosition() : Vec2(windowSize.width, windowSize.height) / 2.0f;
+	Vec2 halfSize = Vec2(windowSize.width, windowSize.height) / 2.0f + Vec2(padding, padding);
+
+	//Get the corners of the view in world space, then bring them into the node's space. This takes care of the node being moved, scaled or rotated
+	Mat4 worldToNode = getWorldToNodeTransform();
+	Vec2 corners[4] =
+	{
+		PointApplyTransform(cameraPosition + Vec2(-halfSize.x, -halfSize.y), worldToNode),
+		PointApplyTransform(cameraPosition + Vec2(halfSize.x, -halfSize.y), worldToNode),
+		PointApplyTransform(cameraPosition + Vec2(-halfSize.x, halfSize.y), worldToNode),
+		PointApplyTransform(cameraPosition + Vec2(halfSize.x, halfSize.y), worldToNode)
+	};
+
+	//Find the box that fits around all four corners
+	float minX = corners[0].x, maxX = corners[0].x, minY = corners[0].y, maxY = corners[0].y;
+
+	for (unsigned int i = 1; i < 4; i++)
+	{
+		minX = std::min(minX, corners[i].x);
+		maxX = std::max(maxX, corners[i].x);
+		minY = std::min(minY, corners[i].y);
+		maxY = std::max(maxY, corners[i].y);
+	}
+
+	return Rect(minX, minY, maxX - minX, maxY - minY);
+}
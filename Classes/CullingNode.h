@@ -0,0 +1,174 @@
+/*
+============================================================
+	Culling Node:
+		- A node that skips drawing anything inside it that is off-screen. Put your world in it instead of adding everything straight to the scene
+			> Ex: CullingNode* world = CullingNode::create(); this->addChild(world); world->addChild(someSprite);
+			> Each child is checked as a whole. If a child is off-screen, it and everything attached to it is skipped without visiting a single node inside it
+			> Group things that are close together under one child (ex: a room) so whole groups are skipped with one check
+		- The area each child covers is worked out once and saved. It is only worked out again when something inside it changes
+			> Branches on screen are checked for changes with the same dirty flags Cocos2D uses, just before they are visited. Moving, scaling, rotating or resizing any node in them, or adding / removing nodes, is noticed automatically
+			> Branches off-screen are never gone through. Only the child itself and nodes running actions are checked, since those are the only ones that move without being visited
+			> Culling nodes can be children of other culling nodes. A change inside the inner one updates the outer one too
+		- Keeps track of how many nodes were visited and culled, and how many draw calls were made, every frame
+			> Get them with CullingNode::getStats(), or add CullingNode::createOverlay() to your scene to see them on screen
+
+	Usage:
+		- You are free to use this class for the case studies and for GDW
+		- You are free to edit / overwrite any or all of this class
+			> It is simply here to make your life easier
+		- You must leave this comment block at the top of the header
+
+	Note:
+		- The area of a node is its content size. Nodes without one (ex: ParticleNode) only count as a single point, so use setPadding() to keep things from popping out at the edges of the screen
+		- TileMapNode already only draws what is on screen, so it doesn't need to go inside a culling node
+============================================================
+*/
+
+#ifndef CULLINGNODE_H
+#define CULLINGNODE_H
+
+//Core Libraries
+#include <unordered_map>
+
+//3rd Party Libraries
+#include "cocos2d.h"
+
+//Namespaces
+using namespace cocos2d;
+
+/*
+	Culling Stats Struct
+	- The counts for a single frame, added up over every culling node
+*/
+struct CullingStats
+{
+	CullingStats();
+
+	unsigned int visitedNodes; //Nodes inside culling nodes that were visited and drawn
+	unsigned int culledNodes; //Nodes inside culling nodes that were skipped because they were off-screen
+	unsigned int culledSubtrees; //How many children of culling nodes were skipped. Each one skips every node attached to it
+	unsigned int boundsUpdates; //How many children had their area worked out again because something changed
+	unsigned int drawCalls; //Draw calls made by the renderer for the whole frame, including things outside culling nodes
+	unsigned int drawnVertices; //Vertices drawn by the renderer for the whole frame
+};
+
+
+
+/*
+	Culling Node Class:
+	> Setters
+		- Set the padding around the screen
+		- Mark a node as changed
+	> Getters
+		- Get the stats from last frame
+	> Methods
+		- Create
+		- Create a stats overlay
+		- Visit (called by Cocos2D)
+*/
+class CullingNode : public Node
+{
+public:
+	//--- Creation ---//
+	/*
+		Create a culling node. It is an autoreleased object like everything else made with create()
+
+		@return Returns -> The new node
+	*/
+	static CullingNode* create();
+
+	/*
+		Create a label that shows the culling stats from last frame. It sits in the top right corner and updates itself
+		Ex: this->addChild(CullingNode::createOverlay());
+
+		@return Returns -> The overlay node. Add it to your scene like any other node
+	*/
+	static Node* createOverlay();
+
+
+
+	//--- Setters ---//
+	/*
+		@param Padding -> How far past the edges of the screen, in pixels, things are still drawn. Defaulted to 0
+	*/
+	void setPadding(float padding);
+
+	/*
+		Tell every culling node above a node that it has changed, so their saved areas are worked out again
+		Only needed when your own code changes a node deep inside a branch that is off-screen (ex: a node moved by its own update(), or an action started on a node while it is off-screen), or for changes that don't touch the node's transform, size or children (ex: a custom node that draws outside its content size)
+
+		@param Node -> The node that was moved, resized, etc.
+	*/
+	static void markDirty(Node* node);
+
+
+
+	//--- Getters ---//
+	/*
+		@return Returns -> The padding around the screen, in pixels
+	*/
+	float getPadding() const;
+
+	/*
+		@return Returns -> The counts from the last frame that was drawn
+	*/
+	static const CullingStats& getStats();
+
+
+
+	//--- Methods ---//
+	virtual void visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags) override; //Visits the children that are on screen and skips the rest. Called by Cocos2D every frame
+	virtual void removeChild(Node* child, bool cleanup = true) override; //Forgets the child's saved area
+	virtual void removeAllChildrenWithCleanup(bool cleanup) override; //Forgets every saved area
+
+protected:
+	//--- Constructor and Destructor ---//
+	CullingNode(); //Use create() instead
+	virtual ~CullingNode();
+
+	virtual bool init() override; //Starts tracking the stats. Called by create()
+
+private:
+	/*
+		Culled Child Struct
+		- The saved area of a single child and the nodes in its branch that are checked for changes
+	*/
+	struct CulledChild
+	{
+		CulledChild();
+
+		Rect bounds; //The area covered by the child and everything attached to it, in the culling node's space
+		Vector<Node*> polledNodes; //The child itself and any node in the branch running an action. Checked every frame, even when off-screen. Retained so a removed node is never used after it is deleted
+		Vector<CullingNode*> innerCullingNodes; //Culling nodes inside the branch. The branch stops at them, since they keep track of their own children
+		ssize_t childCount; //How many children the child had
+		unsigned int nodeCount; //How many nodes are in the subtree, including the child itself and everything inside inner culling nodes
+		unsigned int ownNodeCount; //How many nodes are checked when the branch is on screen. Doesn't include what is inside inner culling nodes
+		uint32_t missedFlags; //Transform changes that happened while the child was culled. Passed on when it is visited again so it doesn't use an old transform
+		bool isDirty; //True if the bounds need to be worked out again
+	};
+
+	//--- Private Data ---//
+	float padding; //How far past the screen things are still drawn
+	std::unordered_map<Node*, CulledChild> culledChildren; //The saved area of every child
+	unsigned int lastPollFrame; //The last frame the children were polled. Stops an inner culling node from being polled twice in one frame
+	bool hasChangedSinceTaken; //True if any saved area changed since an outer culling node last asked
+
+	//--- Static Variables ---//
+	static CullingStats currentStats; //The counts for the frame being drawn
+	static CullingStats lastStats; //The counts for the last frame that finished drawing
+	static bool isTrackingStats; //True once the end of frame listener has been added
+
+	//--- Utility Functions ---//
+	void pollBranches(); //Checks the polled nodes of every child and works out the bounds of the ones that changed. Only runs once a frame
+	bool takeChanges(); //Polls the children, then returns true if any saved area changed since the last call. Used by an outer culling node
+	void updateChildBounds(Node* child, CulledChild& culledChild); //Works out the bounds of a child again and finds the nodes to poll
+	static bool hasBranchChanged(Node* child, const CulledChild& culledChild); //Checks the dirty flags of every visible node in a branch that is about to be visited
+	static bool hasSubtreeChanged(Node* node, const CulledChild& culledChild, unsigned int& nodeCount); //Checks a node and everything attached to it, counting the nodes along the way
+	static void addSubtreeBounds(Node* node, const Mat4& parentToCulling, CulledChild& culledChild, bool& hasBounds); //Adds a node and everything attached to it to the bounds and the node counts
+	void addSavedBounds(const Mat4& nodeToParent, Rect& bounds, bool& hasBounds, unsigned int& nodeCount) const; //Adds this node's saved child areas to the bounds, moved into the parent's space. Used by an outer culling node
+	static uint32_t getDirtyFlags(Node* node); //The transform and size flags Cocos2D clears when a node is visited
+	static void clearDirtyFlags(Node* node); //Clears the flags once they have been moved into a branch's missed flags
+	Rect getViewBounds() const; //The area the camera can see plus the padding, in the culling node's space
+};
+
+#endif
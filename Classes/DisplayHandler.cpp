@@ -1,10 +1,54 @@
 #include "DisplayHandler.h"
+#include "Logger.h"
 
 //--- Static Variables ---//
 DisplayHandler* DisplayHandler::inst = nullptr;
 
 
 
+//--- Present Notifying View ---//
+//The regular Cocos2D window, except it tells the display handler every time a frame is swapped onto the screen. Cocos2D doesn't have an event for this
+class PresentNotifyingView : public GLViewImpl
+{
+public:
+	static PresentNotifyingView* createWithRect(const std::string& viewName, Rect rect, float frameZoomFactor)
+	{
+		//Same as GLViewImpl::createWithRect() but creates this class instead
+		PresentNotifyingView* view = new (std::nothrow) PresentNotifyingView();
+		if (view && view->initWithRect(viewName, rect, frameZoomFactor, false))
+		{
+			view->autorelease();
+			return view;
+		}
+
+		CC_SAFE_DELETE(view);
+		return nullptr;
+	}
+
+	static PresentNotifyingView* createWithFullScreen(const std::string& viewName)
+	{
+		//Same as GLViewImpl::createWithFullScreen() but creates this class instead
+		PresentNotifyingView* view = new (std::nothrow) PresentNotifyingView();
+		if (view && view->initWithFullScreen(viewName))
+		{
+			view->autorelease();
+			return view;
+		}
+
+		CC_SAFE_DELETE(view);
+		return nullptr;
+	}
+
+	virtual void swapBuffers() override
+	{
+		//Show the frame then let everyone know it is on screen
+		GLViewImpl::swapBuffers();
+		DISPLAY->notifyFramePresented();
+	}
+};
+
+
+
 //--- Constructor and Destructor ---//
 DisplayHandler::DisplayHandler()
 {
@@ -57,10 +101,11 @@ void DisplayHandler::init(float windowWidth, float windowHeight, const std::stri
 		if (!glview)
 		{
 			//Create the window using the correct Cocos2D function such that the window size are all synced. Use the fullscreen version if requested
+			//The window is our own version of GLViewImpl so we know when each frame reaches the screen
 			if (useFullscreen)
-				glview = GLViewImpl::createWithFullScreen(windowTitle);
+				glview = PresentNotifyingView::createWithFullScreen(windowTitle);
 			else
-				glview = GLViewImpl::createWithRect(windowTitle, Rect(0.0f, 0.0f, windowWidth, windowHeight), windowScaleFactor, false);
+				glview = PresentNotifyingView::createWithRect(windowTitle, Rect(0.0f, 0.0f, windowWidth, windowHeight), windowScaleFactor);
 
 			//Pass the director singleton the new opengl window
 			director->setOpenGLView(glview);
@@ -75,7 +120,7 @@ void DisplayHandler::init(float windowWidth, float windowHeight, const std::stri
 	else //If the display has already been init
 	{
 		//Since the display has already been initialized, output a warning message. Since it doesn't re-init, it is not a problem but calling this function more than once is a waste and it is improper
-		std::cout << "WARNING: The init() function for the display handler has been called more than once. It should only be called once!" << std::endl;
+		LOG_WARNING("The init() function for the display handler has been called more than once. It should only be called once!");
 	}
 }
 
@@ -95,6 +140,12 @@ void DisplayHandler::createDebugConsole(bool createInReleaseMode)
 #endif
 }
 
+void DisplayHandler::addPresentCallback(const std::function<void()>& callback)
+{
+	//Store the function so it is called after every swap
+	presentCallbacks.push_back(callback);
+}
+
 
 
 //--- Singleton Instance ---//
@@ -118,4 +169,11 @@ void DisplayHandler::openConsoleWindow()
 
 	//Bind the window so that outputs go to it
 	freopen("CONOUT$", "w", stdout);
+}
+
+void DisplayHandler::notifyFramePresented()
+{
+	//Call every registered function now that the frame is on screen
+	for (unsigned int i = 0; i < presentCallbacks.size(); i++)
+		presentCallbacks[i]();
 }
\ No newline at end of file
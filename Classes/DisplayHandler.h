@@ -8,6 +8,7 @@
 		- Simple class to wrap some of the display / windowing calls from Cocos
 		- Call the init() function at the start of the program's execution in order to create a window with the proper dimensions. You should ONLY call this ONCE
 		- Call getWindowSize() to get the width and height of the window in pixels. This returns a "Size" object which is Cocos2D's data type. Size has .width and .height
+		- Call addPresentCallback() to run code right after each frame is actually shown on screen. Useful for timing
 
 	Usage:
 		- You are free to use this class for the case studies and for GDW
@@ -29,6 +30,8 @@
 //Core Libraries
 #include <string>
 #include <iostream>
+#include <vector>
+#include <functional>
 
 //3rd Party Libraries
 #include "cocos2d.h"
@@ -42,6 +45,8 @@ using namespace cocos2d;
 		- Get the size of the window in pixels as 'Size' or as 'Vec2'
 	> Methods
 		- Init
+		- Create debug console
+		- Add present callbacks
 */
 class DisplayHandler
 {
@@ -92,6 +97,13 @@ public:
 	*/
 	void createDebugConsole(bool createInReleaseMode = false);
 
+	/*
+		Register a function that is called every time a frame is shown on screen. It is called right after the buffers are swapped, which is the closest we can get to when the player actually sees the frame
+
+		@param Callback -> The function to call. Ex: DISPLAY->addPresentCallback([]() { LOG_DEBUG("Frame shown!"); });
+	*/
+	void addPresentCallback(const std::function<void()>& callback);
+
 
 
 	//--- Singleton Instance ---//
@@ -106,12 +118,16 @@ private:
 	//--- Private Class Data ---//
 	Size windowSize; //Size (in pixels) of the window. .width and .height can be used to get the information within
 	bool hasBeenInit; //Prevents the display from being init more than once
+	std::vector<std::function<void()>> presentCallbacks; //Functions that are called every time a frame is swapped onto the screen
 
 	//--- Singleton Instance ---//
 	static DisplayHandler* inst; //The singleton instance of this class. Ie: the only instance that can ever exist
 
 	//--- Utility Functions ---//
 	void openConsoleWindow(); //Private function that creates a debug window and binds output to it. Called by createDebugConsole()
+	void notifyFramePresented(); //Calls all of the present callbacks. Called by the window every time it swaps the buffers
+
+	friend class PresentNotifyingView; //The window class that calls notifyFramePresented()
 };
 
 #define DISPLAY DisplayHandler::getInstance() //Macro to make using the class easier. Automatically gets the singleton instance for you
@@ -1,15 +1,19 @@
 #include "HelloWorldScene.h"
-#include "SimpleAudioEngine.h"
 #include "InputHandler.h"
+#include "TweenEngine.h"
+#include "ComboRecognizer.h"
+#include "RollbackManager.h"
+#include "CullingNode.h"
 
 USING_NS_CC;
 
-Scene* HelloWorld::createScene()
+Scene* HelloWorld::createScene(bool usePhysics)
 {
 	//Create the actual scene object that gets used with the director. This function is called within AppDelegate.cpp 
 	//'scene' is an autorelease object so we never have to call delete on it. If we did, your application would likely crash
 	//Important note: Anytime you call ___::create() with Cocos2D, you will be getting an autoreleased object. You do not need to call delete on anything in the Cocos2D engine
-	Scene* scene = Scene::createWithPhysics();
+	//Creating a physics world takes time at startup and every frame after that, so only do it if the scene needs physics. Pass in true to get one
+	Scene* scene = usePhysics ? Scene::createWithPhysics() : Scene::create();
 
 
 
@@ -23,6 +27,7 @@ Scene* HelloWorld::createScene()
 
 	//Return the newly built scene
 	//This is then passed to the director with director->runWithScene() or director->replaceScene() etc. In this case, director->runWithScene() is called in AppDelagate.cpp
+	//Everything in here happens in one frame. For big levels, switch scenes with SCENES->streamScene() instead so the game doesn't freeze while they load (see SceneStreamer.h)
 	return scene;
 }
 
@@ -41,13 +46,32 @@ bool HelloWorld::init()
 	//*** Forum Post: http://discuss.cocos2d-x.org/t/void-update-float-delta-is-not-executing/16614/4 ***//
 	this->scheduleUpdate();
 
+	//Add your level's sprites to the world instead of straight to the scene so the ones that are off-screen aren't drawn
+	//Ex: world->addChild(someSprite);
+	world = CullingNode::create();
+	this->addChild(world);
+
+	//Uncomment this to see how many nodes were drawn and skipped, and how many draw calls were made, every frame
+	//this->addChild(CullingNode::createOverlay(), 100);
+
     return true;
 }
 
 void HelloWorld::update(float deltaTime)
 {
+	//If the scene is run through ROLLBACK->start(), update() is called again for old frames after a rollback. Combos and tweens aren't part of the rolled back state, so they only run on new frames
+	bool isNewFrame = !ROLLBACK->isResimulating();
+
+	//Check for combos added with COMBOS->addCombo(). This has to happen BEFORE the inputs are cleared, otherwise this frame's key presses would be lost
+	if (isNewFrame)
+		COMBOS->update(deltaTime);
+
 	//Update the inputs so they are grabbed from the correct frame
 	//This is a VERY IMPORTANT line of code. It ensures the inputs are updated and synced to the right frame
 	//*** What happens if you remove this line of code? Try to run this scene without it! Hint: Try spawning birds! ***//
 	INPUTS->clearForNextFrame();
+
+	//Advance every tween started with TWEENS-> and write the results to their nodes
+	if (isNewFrame)
+		TWEENS->update(deltaTime);
 }
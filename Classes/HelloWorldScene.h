@@ -3,16 +3,21 @@
 
 #include "cocos2d.h"
 
+class CullingNode;
+
 class HelloWorld : public cocos2d::Scene
 {
 public:
-    static cocos2d::Scene* createScene();
+    static cocos2d::Scene* createScene(bool usePhysics = false);
 
     virtual bool init();
 	void update(float deltaTime);
     
     // implement the "static create()" method manually
     CREATE_FUNC(HelloWorld);
+
+private:
+	CullingNode* world; //Holds everything in the level. Anything in here that is off-screen is skipped when drawing
 };
 
 #endif // __HELLOWORLD_SCENE_H__
@@ -0,0 +1,401 @@
+#include "HotReloader.h"
+#include "Logger.h"
+
+//Core Libraries
+#include <chrono>
+#include <algorithm>
+
+//inotify is only available on Linux
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+#define HOTRELOAD_HAS_INOTIFY 1
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <dirent.h>
+#endif
+
+//--- Static Variables ---//
+HotReloader* HotReloader::inst = nullptr;
+
+//--- Constants ---//
+static const char* TEXTURE_EXTENSIONS[] = { ".png", ".jpg", ".jpeg", ".webp", ".bmp", ".tga", ".tif", ".tiff", ".pvr" }; //Files reloaded as textures
+static const char* FONT_EXTENSIONS[] = { ".ttf", ".otf", ".fnt" }; //Files reloaded as fonts
+
+
+
+//--- Constructor and Destructor ---//
+HotReloader::HotReloader()
+{
+	debounceMilliseconds = 200;
+	isRunning = false;
+	inotifyHandle = -1;
+	wakePipe[0] = -1;
+	wakePipe[1] = -1;
+}
+
+HotReloader::~HotReloader()
+{
+	stop();
+
+	//Delete the singleton instance
+	if (inst)
+		delete inst;
+
+	//Clean up the pointer
+	inst = nullptr;
+}
+
+
+
+//--- Setters ---//
+void HotReloader::setDebounceTime(float seconds)
+{
+	debounceMilliseconds = (int)(seconds * 1000.0f);
+}
+
+void HotReloader::setOnReload(const std::function<void(const std::string& filePath, HotReloadType type)>& callback)
+{
+	onReload = callback;
+}
+
+
+
+//--- Getters ---//
+bool HotReloader::isWatching() const
+{
+	return isRunning;
+}
+
+
+
+//--- Methods ---//
+bool HotReloader::start(const std::string& directory)
+{
+#if HOTRELOAD_HAS_INOTIFY
+	if (isRunning)
+		return true;
+
+	//Use the Resources folder if no folder was given
+	rootDirectory = directory;
+
+	if (rootDirectory.empty() && !FileUtils::getInstance()->getSearchPaths().empty())
+		rootDirectory = FileUtils::getInstance()->getSearchPaths().front();
+
+	if (rootDirectory.empty())
+	{
+		LOG_ERROR("HotReloader: there is no folder to watch");
+		return false;
+	}
+
+	if (rootDirectory.back() != '/')
+		rootDirectory += '/';
+
+	inotifyHandle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+	if (inotifyHandle < 0 || pipe(wakePipe) != 0)
+	{
+		LOG_ERROR("HotReloader: could not start inotify");
+		stop();
+		return false;
+	}
+
+	watchDirectory("");
+
+	isRunning = true;
+	thread = std::thread(&HotReloader::run, this);
+
+	LOG_INFO("HotReloader: watching {} folders in {}", (unsigned int)watchedDirectories.size(), rootDirectory);
+	return true;
+#else
+	LOG_WARNING("HotReloader: hot reloading is only available on Linux");
+	return false;
+#endif
+}
+
+void HotReloader::stop()
+{
+#if HOTRELOAD_HAS_INOTIFY
+	//Wake the watcher thread up and wait for it to finish
+	if (isRunning.exchange(false))
+	{
+		char wake = 1;
+		ssize_t written = write(wakePipe[1], &wake, 1);
+		(void)written;
+		thread.join();
+	}
+
+	if (inotifyHandle >= 0)
+		close(inotifyHandle);
+
+	for (int i = 0; i < 2; i++)
+	{
+		if (wakePipe[i] >= 0)
+			close(wakePipe[i]);
+
+		wakePipe[i] = -1;
+	}
+
+	inotifyHandle = -1;
+	watchedDirectories.clear();
+#endif
+}
+
+void HotReloader::addDataListener(const std::string& filePath, const std::function<void(const std::string& contents)>& callback)
+{
+	std::lock_guard<std::mutex> lock(listenersMutex);
+	dataListeners[filePath] = callback;
+}
+
+void HotReloader::removeDataListener(const std::string& filePath)
+{
+	std::lock_guard<std::mutex> lock(listenersMutex);
+	dataListeners.erase(filePath);
+}
+
+
+
+//--- Singleton Instance ---//
+HotReloader* HotReloader::getInstance()
+{
+	//Generate the singleton if it hasn't been created yet
+	if (!inst)
+		inst = new HotReloader();
+
+	//Return the singleton
+	return inst;
+}
+
+
+
+//--- Utility Functions ---//
+void HotReloader::run()
+{
+#if HOTRELOAD_HAS_INOTIFY
+	typedef std::chrono::steady_clock Clock;
+	std::unordered_map<std::string, Clock::time_point> pendingFiles; //Files that changed and when they last changed. Reloaded once they have been quiet for the debounce time
+	alignas(struct inotify_event) char buffer[4096];
+
+	while (isRunning)
+	{
+		//Sleep until something changes. If files are waiting on the debounce, only sleep until the first one is ready
+		int timeout = -1;
+		Clock::time_point now = Clock::now();
+		std::chrono::milliseconds debounce(debounceMilliseconds.load());
+
+		for (auto& pending : pendingFiles)
+		{
+			int remaining = (int)std::chrono::duration_cast<std::chrono::milliseconds>(pending.second + debounce - now).count();
+			remaining = std::max(remaining, 0);
+			timeout = (timeout < 0) ? remaining : std::min(timeout, remaining);
+		}
+
+		pollfd handles[2] = { { inotifyHandle, POLLIN, 0 }, { wakePipe[0], POLLIN, 0 } };
+		poll(handles, 2, timeout);
+
+		//stop() was called
+		if (handles[1].revents & POLLIN)
+			break;
+
+		//Read every change that has happened
+		ssize_t length;
+
+		while ((length = read(inotifyHandle, buffer, sizeof(buffer))) > 0)
+		{
+			for (char* position = buffer; position < buffer + length; )
+			{
+				const inotify_event* event = (const inotify_event*)position;
+				position += sizeof(inotify_event) + event->len;
+
+				auto directory = watchedDirectories.find(event->wd);
+
+				if (directory == watchedDirectories.end() || event->len == 0)
+					continue;
+
+				std::string relativePath = directory->second + event->name;
+
+				//A new folder was made or moved in. Watch it too
+				if (event->mask & IN_ISDIR)
+				{
+					if (event->mask & (IN_CREATE | IN_MOVED_TO))
+						watchDirectory(relativePath + "/");
+
+					continue;
+				}
+
+				pendingFiles[relativePath] = Clock::now();
+			}
+		}
+
+		//Reload the files that have stopped changing
+		now = Clock::now();
+
+		for (auto pending = pendingFiles.begin(); pending != pendingFiles.end(); )
+		{
+			if (now - pending->second >= debounce)
+			{
+				reload(pending->first);
+				pending = pendingFiles.erase(pending);
+			}
+			else
+				pending++;
+		}
+	}
+#endif
+}
+
+void HotReloader::watchDirectory(const std::string& relativePath)
+{
+#if HOTRELOAD_HAS_INOTIFY
+	std::string fullPath = rootDirectory + relativePath;
+
+	//Files are reloaded once they are closed after writing or moved into place (editors often save to a temporary file and rename it)
+	int watch = inotify_add_watch(inotifyHandle, fullPath.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+
+	if (watch < 0)
+		return;
+
+	watchedDirectories[watch] = relativePath;
+
+	//inotify only watches one folder, so every folder inside it needs its own watch
+	DIR* directory = opendir(fullPath.c_str());
+
+	if (!directory)
+		return;
+
+	while (dirent* entry = readdir(directory))
+	{
+		std::string name = entry->d_name;
+
+		if (name == "." || name == "..")
+			continue;
+
+		if (entry->d_type == DT_DIR)
+			watchDirectory(relativePath + name + "/");
+	}
+
+	closedir(directory);
+#endif
+}
+
+void HotReloader::reload(const std::string& relativePath)
+{
+	std::string fullPath = rootDirectory + relativePath;
+	HotReloadType type = getType(relativePath);
+	Scheduler* scheduler = Director::getInstance()->getScheduler();
+
+	if (type == HotReloadType::Texture)
+	{
+		//Decode the image here so the main thread only has to upload it
+		Image* image = new (std::nothrow) Image();
+
+		if (!image || !image->initWithImageFile(fullPath))
+		{
+			LOG_WARNING("HotReloader: could not load {}", relativePath);
+			CC_SAFE_RELEASE(image);
+			return;
+		}
+
+		scheduler->performFunctionInCocosThread([this, image, fullPath, relativePath]()
+		{
+			//Only textures that are already loaded are reloaded. Reusing the same Texture2D means every sprite using it updates automatically
+			//The texture cache is keyed by full paths, so the watched folder is added on
+			Texture2D* texture = Director::getInstance()->getTextureCache()->getTextureForKey(fullPath);
+
+			if (texture)
+			{
+				texture->initWithImage(image);
+				finishReload(relativePath, HotReloadType::Texture);
+			}
+
+			image->release();
+		});
+	}
+	else if (type == HotReloadType::Font)
+	{
+		bool isBitmapFont = (relativePath.size() >= 4 && relativePath.compare(relativePath.size() - 4, 4, ".fnt") == 0);
+		std::string fontName = getFontName(fullPath);
+
+		scheduler->performFunctionInCocosThread([this, isBitmapFont, fontName, relativePath]()
+		{
+			//The old atlas is thrown away. New labels load the new file, and labels that already exist pick it up once their font is set again (ex: in the setOnReload() callback)
+			//Unlike textures, fonts are cached by the name the game used (ex: "fonts/arial.ttf"), not by their full path
+			if (isBitmapFont)
+				FontAtlasCache::reloadFontAtlasFNT(fontName);
+			else
+				FontAtlasCache::unloadFontAtlasTTF(fontName);
+
+			finishReload(relativePath, HotReloadType::Font);
+		});
+	}
+	else
+	{
+		std::function<void(const std::string&)> listener;
+
+		{
+			std::lock_guard<std::mutex> lock(listenersMutex);
+			auto found = dataListeners.find(relativePath);
+
+			if (found != dataListeners.end())
+				listener = found->second;
+		}
+
+		//Nobody cares about this file
+		if (!listener)
+			return;
+
+		std::string contents = FileUtils::getInstance()->getStringFromFile(fullPath);
+
+		scheduler->performFunctionInCocosThread([this, listener, contents, relativePath]()
+		{
+			listener(contents);
+			finishReload(relativePath, HotReloadType::Data);
+		});
+	}
+}
+
+void HotReloader::finishReload(const std::string& relativePath, HotReloadType type)
+{
+	LOG_INFO("HotReloader: reloaded {}", relativePath);
+
+	if (onReload)
+		onReload(relativePath, type);
+}
+
+std::string HotReloader::getFontName(const std::string& fullPath)
+{
+	//Labels are normally made with paths relative to the Resources folder, so that is the name the font is cached under
+	const std::vector<std::string>& searchPaths = FileUtils::getInstance()->getSearchPaths();
+
+	for (const std::string& searchPath : searchPaths)
+	{
+		if (!searchPath.empty() && fullPath.compare(0, searchPath.size(), searchPath) == 0)
+			return fullPath.substr(searchPath.size() + ((searchPath.back() == '/') ? 0 : 1));
+	}
+
+	return fullPath;
+}
+
+HotReloadType HotReloader::getType(const std::string& filePath)
+{
+	size_t dot = filePath.find_last_of('.');
+
+	if (dot == std::string::npos)
+		return HotReloadType::Data;
+
+	std::string extension = filePath.substr(dot);
+	std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+	for (const char* textureExtension : TEXTURE_EXTENSIONS)
+	{
+		if (extension == textureExtension)
+			return HotReloadType::Texture;
+	}
+
+	for (const char* fontExtension : FONT_EXTENSIONS)
+	{
+		if (extension == fontExtension)
+			return HotReloadType::Font;
+	}
+
+	return HotReloadType::Data;
+}
@@ -0,0 +1,175 @@
+/*
+============================================================
+	Hot Reloader:
+		- Reloads assets while the game is running as soon as they are saved, so you don't have to restart to see a change
+			> Textures that are already loaded are reloaded in place. Every sprite using them shows the new image right away without rebuilding the scene
+			> Fonts (.fnt, .ttf, .otf) are reloaded into a new atlas, so new labels use the new file. Labels that already exist keep the old atlas, so set their font again in setOnReload() to update them
+			> Data files (levels, configs...) are read in the background and handed to the functions you register with addDataListener()
+		- Linux only. It uses inotify to be told about changes instead of checking every file over and over
+			> Call HOTRELOAD->start() once (ex: in AppDelegate after the window is created). Nothing is watched and nothing runs until then, so there is no cost if you never call it
+			> Saving a file usually causes several changes in a row (write, rename, touch). They are grouped together and the file is only reloaded once they stop
+		- The files are read and decoded on the watcher thread. Only the GPU upload and your callbacks run on the main thread
+
+	Usage:
+		- You are free to use this class for the case studies and for GDW
+		- You are free to edit / overwrite any or all of this class
+			> It is simply here to make your life easier
+		- You must leave this comment block at the top of the header
+
+	Note:
+		- This class uses the Singleton design pattern
+			> Do not ever make more than one instance of this class in its current form
+			> You don't ever have to call the constructor for this class. Simply start using it and it will build itself
+			> There is a macro "HOTRELOAD->" that provides a shortcut for getting the singleton instance
+		- A reloaded texture should stay the same size. Sprites keep their old texture rectangles, so a bigger or smaller image will look stretched or cut off
+		- Only meant for development. Don't ship a game with it turned on
+============================================================
+*/
+
+#ifndef HOTRELOADER_H
+#define HOTRELOADER_H
+
+//Core Libraries
+#include <string>
+#include <unordered_map>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <atomic>
+
+//3rd Party Libraries
+#include "cocos2d.h"
+
+//Namespaces
+using namespace cocos2d;
+
+/*
+	Hot Reload Type Enum
+	- The kinds of files the hot reloader knows how to reload. Picked from the file extension
+*/
+enum class HotReloadType
+{
+	Texture, //.png, .jpg, .jpeg, .webp, .bmp, .tga, .tif, .tiff, .pvr
+	Font, //.ttf, .otf, .fnt
+	Data //Anything else. Only reloaded if it has a listener
+};
+
+
+
+/*
+	Hot Reloader Class:
+	> Setters
+		- Set the debounce time
+		- Set a callback for every reload
+	> Getters
+		- Get if it is watching
+	> Methods
+		- Start / stop watching
+		- Listen for changes to a data file
+*/
+class HotReloader
+{
+protected:
+	//--- Constructor ---//
+	HotReloader(); //The constructor is protected so only one instance of this class can ever exist. This is called the singleton pattern.
+
+public:
+	//--- Destructor ---//
+	~HotReloader();
+
+
+
+	//--- Setters ---//
+	/*
+		Set how long a file has to stay unchanged before it is reloaded. Stops a file from being reloaded several times while it is still being saved
+
+		@param Seconds -> Defaulted to 0.2 seconds
+	*/
+	void setDebounceTime(float seconds);
+
+	/*
+		Run a function on the main thread after every file is reloaded. Useful for refreshing anything that doesn't update itself (ex: resetting a label's font)
+
+		@param Callback -> The function to run. Gets the path of the file, relative to the watched folder, and its type
+	*/
+	void setOnReload(const std::function<void(const std::string& filePath, HotReloadType type)>& callback);
+
+
+
+	//--- Getters ---//
+	/*
+		@return Returns -> True if files are being watched
+	*/
+	bool isWatching() const;
+
+
+
+	//--- Methods ---//
+	/*
+		Start watching a folder and every folder inside it. Only works on Linux, returns false everywhere else
+
+		@param Directory (optional) -> The folder to watch. Defaulted to the first search path, which is the Resources folder
+		@return Returns -> True if the folder is being watched
+	*/
+	bool start(const std::string& directory = "");
+
+	/*
+		Stop watching and shut down the watcher thread
+	*/
+	void stop();
+
+	/*
+		Run a function on the main thread every time a data file changes. The file is read on the watcher thread so your function gets the new contents right away
+
+		@param FilePath -> The file, relative to the watched folder. Ex: "levels/level1.txt"
+		@param Callback -> Gets the new contents of the file. Ex: [this](const std::string& contents) { loadLevel(contents); }
+	*/
+	void addDataListener(const std::string& filePath, const std::function<void(const std::string& contents)>& callback);
+
+	/*
+		Stop listening to a data file
+
+		@param FilePath -> The same path given to addDataListener()
+	*/
+	void removeDataListener(const std::string& filePath);
+
+
+
+	//--- Singleton Instance ---//
+	/*
+		Get the instance of the singleton. You shouldn't ever need to call this directly since the macro (HOTRELOAD->) automatically calls it
+
+		@return Returns -> The singleton instance of this class. This is the ONLY instance of this class so intrefacing HAS to be done through this instance.
+	*/
+	static HotReloader* getInstance();
+
+private:
+	//--- Private Data ---//
+	std::string rootDirectory; //The folder being watched, ending in a /
+	std::atomic<int> debounceMilliseconds; //How long a file has to stay unchanged before it is reloaded
+	std::function<void(const std::string&, HotReloadType)> onReload; //Run after every reload
+
+	std::unordered_map<std::string, std::function<void(const std::string&)>> dataListeners; //The data files being listened to and their callbacks
+	std::mutex listenersMutex; //Guards dataListeners, since the watcher thread checks it
+
+	std::thread thread; //The watcher thread
+	std::atomic<bool> isRunning; //True while the watcher thread should keep going
+	int inotifyHandle; //The inotify instance. -1 if it isn't open
+	int wakePipe[2]; //Written to by stop() to wake the watcher thread up
+	std::unordered_map<int, std::string> watchedDirectories; //Each inotify watch and the folder it is for, relative to the root
+
+	//--- Singleton Instance ---//
+	static HotReloader* inst; //The singleton instance of this class. Ie: the only instance that can ever exist
+
+	//--- Utility Functions ---//
+	void run(); //The watcher thread's loop
+	void watchDirectory(const std::string& relativePath); //Adds a watch to a folder and every folder inside it
+	void reload(const std::string& relativePath); //Reloads a changed file. Called on the watcher thread
+	void finishReload(const std::string& relativePath, HotReloadType type); //Runs the reload callback. Called on the main thread
+	static std::string getFontName(const std::string& fullPath); //Works out the name a font is cached under, which is its path relative to the search path it is in
+	static HotReloadType getType(const std::string& filePath); //Works out the type from the file extension
+};
+
+#define HOTRELOAD HotReloader::getInstance() //Macro to make using the class easier. Automatically gets the singleton instance for you
+
+#endif
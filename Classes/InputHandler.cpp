@@ -1,10 +1,155 @@
 #include "InputHandler.h"
 #include "DisplayHandler.h"
+#include "LatencyTracker.h"
+
+//Core Libraries
+#include <cstring>
 
 //--- Static Variables ---//
 InputHandler* InputHandler::inst = 0;
 
 
+
+//--- GLFW Polling ---//
+//GLFW is only available on the desktop platforms
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32 || CC_TARGET_PLATFORM == CC_PLATFORM_MAC || CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+#define INPUT_HAS_GLFW 1
+
+//A GLFW key and the Cocos2D key it turns into. This is the same mapping Cocos2D uses internally so both backends give the same results
+struct GLFWKeyMapping
+{
+	int glfwKey;
+	KeyCode keyCode;
+};
+
+//The keys that don't come in a continuous range. Letters, numbers and function keys are added in a loop in initGLFWPolling()
+static const GLFWKeyMapping GLFW_KEY_MAP[] =
+{
+	{ GLFW_KEY_SPACE, KeyCode::KEY_SPACE },
+	{ GLFW_KEY_APOSTROPHE, KeyCode::KEY_APOSTROPHE },
+	{ GLFW_KEY_COMMA, KeyCode::KEY_COMMA },
+	{ GLFW_KEY_MINUS, KeyCode::KEY_MINUS },
+	{ GLFW_KEY_PERIOD, KeyCode::KEY_PERIOD },
+	{ GLFW_KEY_SLASH, KeyCode::KEY_SLASH },
+	{ GLFW_KEY_SEMICOLON, KeyCode::KEY_SEMICOLON },
+	{ GLFW_KEY_EQUAL, KeyCode::KEY_EQUAL },
+	{ GLFW_KEY_LEFT_BRACKET, KeyCode::KEY_LEFT_BRACKET },
+	{ GLFW_KEY_BACKSLASH, KeyCode::KEY_BACK_SLASH },
+	{ GLFW_KEY_RIGHT_BRACKET, KeyCode::KEY_RIGHT_BRACKET },
+	{ GLFW_KEY_GRAVE_ACCENT, KeyCode::KEY_GRAVE },
+	{ GLFW_KEY_ESCAPE, KeyCode::KEY_ESCAPE },
+	{ GLFW_KEY_ENTER, KeyCode::KEY_ENTER },
+	{ GLFW_KEY_TAB, KeyCode::KEY_TAB },
+	{ GLFW_KEY_BACKSPACE, KeyCode::KEY_BACKSPACE },
+	{ GLFW_KEY_INSERT, KeyCode::KEY_INSERT },
+	{ GLFW_KEY_DELETE, KeyCode::KEY_DELETE },
+	{ GLFW_KEY_RIGHT, KeyCode::KEY_RIGHT_ARROW },
+	{ GLFW_KEY_LEFT, KeyCode::KEY_LEFT_ARROW },
+	{ GLFW_KEY_DOWN, KeyCode::KEY_DOWN_ARROW },
+	{ GLFW_KEY_UP, KeyCode::KEY_UP_ARROW },
+	{ GLFW_KEY_PAGE_UP, KeyCode::KEY_PG_UP },
+	{ GLFW_KEY_PAGE_DOWN, KeyCode::KEY_PG_DOWN },
+	{ GLFW_KEY_HOME, KeyCode::KEY_HOME },
+	{ GLFW_KEY_END, KeyCode::KEY_END },
+	{ GLFW_KEY_CAPS_LOCK, KeyCode::KEY_CAPS_LOCK },
+	{ GLFW_KEY_SCROLL_LOCK, KeyCode::KEY_SCROLL_LOCK },
+	{ GLFW_KEY_NUM_LOCK, KeyCode::KEY_NUM_LOCK },
+	{ GLFW_KEY_PRINT_SCREEN, KeyCode::KEY_PRINT },
+	{ GLFW_KEY_PAUSE, KeyCode::KEY_PAUSE },
+	{ GLFW_KEY_KP_DECIMAL, KeyCode::KEY_PERIOD },
+	{ GLFW_KEY_KP_DIVIDE, KeyCode::KEY_KP_DIVIDE },
+	{ GLFW_KEY_KP_MULTIPLY, KeyCode::KEY_KP_MULTIPLY },
+	{ GLFW_KEY_KP_SUBTRACT, KeyCode::KEY_KP_MINUS },
+	{ GLFW_KEY_KP_ADD, KeyCode::KEY_KP_PLUS },
+	{ GLFW_KEY_KP_ENTER, KeyCode::KEY_KP_ENTER },
+	{ GLFW_KEY_KP_EQUAL, KeyCode::KEY_EQUAL },
+	{ GLFW_KEY_LEFT_SHIFT, KeyCode::KEY_LEFT_SHIFT },
+	{ GLFW_KEY_LEFT_CONTROL, KeyCode::KEY_LEFT_CTRL },
+	{ GLFW_KEY_LEFT_ALT, KeyCode::KEY_LEFT_ALT },
+	{ GLFW_KEY_LEFT_SUPER, KeyCode::KEY_HYPER },
+	{ GLFW_KEY_RIGHT_SHIFT, KeyCode::KEY_RIGHT_SHIFT },
+	{ GLFW_KEY_RIGHT_CONTROL, KeyCode::KEY_RIGHT_CTRL },
+	{ GLFW_KEY_RIGHT_ALT, KeyCode::KEY_RIGHT_ALT },
+	{ GLFW_KEY_RIGHT_SUPER, KeyCode::KEY_HYPER },
+	{ GLFW_KEY_MENU, KeyCode::KEY_MENU }
+};
+
+static std::vector<GLFWKeyMapping> glfwKeyMappings; //Every GLFW key that is polled and the Cocos2D key it turns into. Built in initGLFWPolling()
+static GLFWwindow* glfwWindow = nullptr; //The window the inputs are read from
+static GLFWscrollfun previousScrollCallback = nullptr; //Cocos2D's own scroll callback. Still called after ours so nothing else breaks
+
+#endif
+
+
+
+//--- Input Snapshot ---//
+InputSnapshot::InputSnapshot()
+{
+	//Zero every byte so two snapshots of the same inputs are always identical when compared with memcmp. Idle is 0
+	memset(this, 0, sizeof(InputSnapshot));
+}
+
+Vec2 InputSnapshot::getMousePosition() const
+{
+	return Vec2(mouseX, mouseY);
+}
+
+bool InputSnapshot::getMouseButtonPress(MouseButton button) const
+{
+	return (mouseStates[(int)button + 1] == InputState::Pressed);
+}
+
+bool InputSnapshot::getMouseButtonRelease(MouseButton button) const
+{
+	return (mouseStates[(int)button + 1] == InputState::Released);
+}
+
+bool InputSnapshot::getMouseButton(MouseButton button) const
+{
+	return (mouseStates[(int)button + 1] == InputState::Pressed || mouseStates[(int)button + 1] == InputState::Held);
+}
+
+bool InputSnapshot::getKeyPress(KeyCode key) const
+{
+	return (keyboardStates[(int)key] == InputState::Pressed);
+}
+
+bool InputSnapshot::getKeyRelease(KeyCode key) const
+{
+	return (keyboardStates[(int)key] == InputState::Released);
+}
+
+bool InputSnapshot::getKey(KeyCode key) const
+{
+	return (keyboardStates[(int)key] == InputState::Pressed || keyboardStates[(int)key] == InputState::Held);
+}
+
+void InputSnapshot::clearForNextFrame()
+{
+	//The same rules as InputHandler::clearForNextFrame()
+	for (unsigned int i = 0; i < NUM_MOUSE_BUTTONS; i++)
+	{
+		if (mouseStates[i] == InputState::Pressed)
+			mouseStates[i] = InputState::Held;
+		else if (mouseStates[i] == InputState::Released)
+			mouseStates[i] = InputState::Idle;
+	}
+
+	for (unsigned int i = 0; i < NUM_KEY_CODES; i++)
+	{
+		if (keyboardStates[i] == InputState::Pressed)
+			keyboardStates[i] = InputState::Held;
+		else if (keyboardStates[i] == InputState::Released)
+			keyboardStates[i] = InputState::Idle;
+	}
+
+	scrollValue = 0.0f;
+	horizontalScrollValue = 0.0f;
+	frameNumber++;
+}
+
+
+
 //--- Constructor and Destructor ---//
 InputHandler::InputHandler()
 	: Node()
@@ -12,11 +157,24 @@ InputHandler::InputHandler()
 	//Init the engine variables
 	windowDimensions = DISPLAY->getWindowSize();
 	exitOnEscape = true;
+	inputBackend = InputBackend::EventDispatcher;
+	frameNumber = 0;
+	mouseListener = nullptr;
+	keyboardListener = nullptr;
 
 	//Init the mouse variables
 	mousePosition = Vec2(0.0f, 0.0f);
 	scrollValue = 0.0f;
 	horizontalScrollValue = 0.0f;
+
+	//Init the latency timestamps. 0 means there is no input waiting to be read
+	for (unsigned int i = 0; i < NUM_MOUSE_BUTTONS; i++)
+		mouseEventTimes[i] = 0;
+
+	for (unsigned int i = 0; i < NUM_KEY_CODES; i++)
+		keyboardEventTimes[i] = 0;
+
+	mouseMoveEventTime = 0;
 }
 
 InputHandler::~InputHandler()
@@ -51,24 +209,28 @@ void InputHandler::setExitOnEscape(bool _exitOnEscape)
 Vec2 InputHandler::getMousePosition() const 
 {
 	//Return the position of the mouse cursor, from the BOTTOM LEFT! Flipped on the y-axis from the value that Cocos returns
+	markRead(mouseMoveEventTime);
 	return mousePosition;
 }
 
 bool InputHandler::getMouseButtonPress(MouseButton button) const
 {
 	//If the mouse button requested is set to pressed, it was pressed this exact frame. +1 since the first mouse button is set to -1
+	markRead(mouseEventTimes[(int)button + 1]);
 	return (mouseStates[(int)button + 1] == InputState::Pressed);
 }
 
 bool InputHandler::getMouseButtonRelease(MouseButton button) const
 {
 	//If the mouse button requested is set to released, it was released this exact frame. +1 since the first mouse button is set to -1
+	markRead(mouseEventTimes[(int)button + 1]);
 	return (mouseStates[(int)button + 1] == InputState::Released);
 }
 
 bool InputHandler::getMouseButton(MouseButton button) const
 {
 	//If the mouse button requested is set to pressed OR set to held, it is currently down and so should return true
+	markRead(mouseEventTimes[(int)button + 1]);
 	return (mouseStates[(int)button + 1] == InputState::Pressed || mouseStates[(int)button + 1] == InputState::Held);
 }
 
@@ -90,18 +252,21 @@ float InputHandler::getHorizontalMouseScroll() const
 bool InputHandler::getKeyPress(KeyCode key) const
 {
 	//If the key requested is set to pressed, it was pressed this exact frame
+	markRead(keyboardEventTimes[(int)key]);
 	return (keyboardStates[(int)key] == InputState::Pressed);
 }
 
 bool InputHandler::getKeyRelease(KeyCode key) const
 {
 	//If the key requested is set to released, it was released this exact frame
+	markRead(keyboardEventTimes[(int)key]);
 	return (keyboardStates[(int)key] == InputState::Released);
 }
 
 bool InputHandler::getKey(KeyCode key) const
 {
 	//If the key requested is set to pressed OR set to held, it is currently down and so should return true
+	markRead(keyboardEventTimes[(int)key]);
 	return (keyboardStates[(int)key] == InputState::Pressed || keyboardStates[(int)key] == InputState::Held);
 }
 
@@ -114,7 +279,10 @@ bool InputHandler::getAnyButtonPress() const
 	{
 		//Immediately return true upon finding a single button that was pressed
 		if (mouseStates[i] == InputState::Pressed)
+		{
+			markRead(mouseEventTimes[i]);
 			return true;
+		}
 	}
 
 	//If no mouse buttons were pressed, move to checking the keyboard. If any key was pressed, immediately return true
@@ -122,7 +290,10 @@ bool InputHandler::getAnyButtonPress() const
 	{
 		//Immediately return true upon finding a single button that was pressed
 		if (keyboardStates[i] == InputState::Pressed)
+		{
+			markRead(keyboardEventTimes[i]);
 			return true;
+		}
 	}
 
 	//Return false if absolutely no buttons were pressed and so it reached this point
@@ -136,7 +307,10 @@ bool InputHandler::getAnyButtonRelease() const
 	{
 		//Immediately return true upon finding a single button that was released
 		if (mouseStates[i] == InputState::Released)
+		{
+			markRead(mouseEventTimes[i]);
 			return true;
+		}
 	}
 
 	//If no mouse buttons were pressed, move to checking the keyboard. If any key was released, immediately return true
@@ -144,7 +318,10 @@ bool InputHandler::getAnyButtonRelease() const
 	{
 		//Immediately return true upon finding a single button that was released
 		if (keyboardStates[i] == InputState::Released)
+		{
+			markRead(keyboardEventTimes[i]);
 			return true;
+		}
 	}
 
 	//Return false if absolutely no buttons were released and so it reached this point
@@ -158,7 +335,10 @@ bool InputHandler::getAnyButton() const
 	{
 		//Immediately return true upon finding a single button that was released
 		if (mouseStates[i] == InputState::Pressed || mouseStates[i] == InputState::Held)
+		{
+			markRead(mouseEventTimes[i]);
 			return true;
+		}
 	}
 
 	//If no mouse buttons were pressed, move to checking the keyboard. If any key is down, immediately return true
@@ -166,22 +346,71 @@ bool InputHandler::getAnyButton() const
 	{
 		//Immediately return true upon finding a single button that was released
 		if (keyboardStates[i] == InputState::Released || keyboardStates[i] == InputState::Held)
+		{
+			markRead(keyboardEventTimes[i]);
 			return true;
+		}
 	}
 
 	//Return false if absolutely no buttons are down and so it reached this point
 	return false;
 }
 
+unsigned int InputHandler::getFrameNumber() const
+{
+	return frameNumber;
+}
+
+
+//Snapshots
+void InputHandler::saveState(InputSnapshot& snapshot) const
+{
+	snapshot.frameNumber = frameNumber;
+	snapshot.mouseX = mousePosition.x;
+	snapshot.mouseY = mousePosition.y;
+	snapshot.scrollValue = scrollValue;
+	snapshot.horizontalScrollValue = horizontalScrollValue;
+
+	//The states are plain arrays on both sides so they can be copied in one go
+	memcpy(snapshot.mouseStates, mouseStates, sizeof(mouseStates));
+	memcpy(snapshot.keyboardStates, keyboardStates, sizeof(keyboardStates));
+}
+
+void InputHandler::loadState(const InputSnapshot& snapshot)
+{
+	frameNumber = snapshot.frameNumber;
+	mousePosition = Vec2(snapshot.mouseX, snapshot.mouseY);
+	scrollValue = snapshot.scrollValue;
+	horizontalScrollValue = snapshot.horizontalScrollValue;
+
+	memcpy(mouseStates, snapshot.mouseStates, sizeof(mouseStates));
+	memcpy(keyboardStates, snapshot.keyboardStates, sizeof(keyboardStates));
+}
+
 
 
 //--- Methods ---//
 bool InputHandler::init()
+{
+	//Use the event dispatcher by default
+	return init(InputBackend::EventDispatcher);
+}
+
+bool InputHandler::init(InputBackend backend)
 {
 	//Ensure the parent class was init first
 	if (!Node::init())
 		return false;
 
+	//Try to read the window directly if that was requested. If there is no GLFW window to read from, fall back to the event dispatcher
+	if (backend == InputBackend::GLFWPolling && initGLFWPolling())
+	{
+		inputBackend = InputBackend::GLFWPolling;
+		return true;
+	}
+
+	inputBackend = InputBackend::EventDispatcher;
+
 	//Set up the mouse callbacks
 	initMouseListener();
 
@@ -192,6 +421,47 @@ bool InputHandler::init()
 	return true;
 }
 
+void InputHandler::update(float deltaTime)
+{
+#if INPUT_HAS_GLFW
+	//Only the polling backend needs to do anything each frame
+	if (inputBackend != InputBackend::GLFWPolling)
+		return;
+
+	//Read every key. Some Cocos2D keys have more than one GLFW key (ex: the number row and the number pad) so they are down if any of them are down
+	bool keysDown[NUM_KEY_CODES] = { false };
+
+	for (unsigned int i = 0; i < glfwKeyMappings.size(); i++)
+	{
+		if (glfwGetKey(glfwWindow, glfwKeyMappings[i].glfwKey) == GLFW_PRESS)
+			keysDown[(int)glfwKeyMappings[i].keyCode] = true;
+	}
+
+	for (unsigned int i = 0; i < NUM_KEY_CODES; i++)
+		setKeyDown(i, keysDown[i]);
+
+	//Read the mouse buttons. The GLFW buttons line up with the Cocos2D ones, +1 to compensate for the enum in Cocos starting at -1
+	for (int i = GLFW_MOUSE_BUTTON_1; i <= GLFW_MOUSE_BUTTON_8; i++)
+		setMouseButtonDown(i + 1, glfwGetMouseButton(glfwWindow, i) == GLFW_PRESS);
+
+	//Read the cursor and convert it the same way Cocos2D does. GLFW gives the position in window pixels from the TOP LEFT
+	GLViewImpl* glview = static_cast<GLViewImpl*>(Director::getInstance()->getOpenGLView());
+	double cursorX, cursorY;
+	glfwGetCursorPos(glfwWindow, &cursorX, &cursorY);
+
+	float zoomFactor = glview->getFrameZoomFactor() / glview->getRetinaFactor();
+	Rect viewport = glview->getViewPortRect();
+	Vec2 newMousePosition = Vec2(((float)cursorX / zoomFactor - viewport.origin.x) / glview->getScaleX(), (viewport.origin.y + viewport.size.height - (float)cursorY / zoomFactor) / glview->getScaleY());
+
+	//Only count it as a mouse move if the cursor actually moved
+	if (newMousePosition != mousePosition)
+	{
+		mousePosition = newMousePosition;
+		tagEvent(mouseMoveEventTime);
+	}
+#endif
+}
+
 void InputHandler::clearForNextFrame()
 {
 	//Loop through the mouse buttons and update their states. If they were pressed last frame, they are now held. If they were released last frame, they are now idle.
@@ -225,6 +495,14 @@ void InputHandler::clearForNextFrame()
 	//Reset the scroll wheel amounts to 0
 	scrollValue = 0.0f;
 	horizontalScrollValue = 0.0f;
+
+	//Forget the latency times of any inputs gameplay didn't read this frame. Otherwise a key nobody checks would keep its time for minutes and record a huge latency once it is finally read
+	memset(mouseEventTimes, 0, sizeof(mouseEventTimes));
+	memset(keyboardEventTimes, 0, sizeof(keyboardEventTimes));
+	mouseMoveEventTime = 0;
+
+	//Move on to the next frame
+	frameNumber++;
 }
 
 
@@ -252,6 +530,7 @@ void InputHandler::initMouseListener()
 
 		//Set the appropriate mouse button to be pressed (+1 to compensate for the enum in Cocos starting at -1)
 		mouseStates[(int)mouseButton + 1] = InputState::Pressed;
+		tagEvent(mouseEventTimes[(int)mouseButton + 1]);
 	};
 
 
@@ -272,6 +551,7 @@ void InputHandler::initMouseListener()
 
 		//Set the appropriate mouse button to be released (+1 to compensate for the enum in Cocos starting at -1)
 		mouseStates[(int)mouseButton + 1] = InputState::Released;
+		tagEvent(mouseEventTimes[(int)mouseButton + 1]);
 	};
 
 
@@ -286,6 +566,7 @@ void InputHandler::initMouseListener()
 
 		//Store the cursor position with a FLIPPED Y. To do this, add the height of the window to the position
 		mousePosition = Vec2(mouseEventPos.x, mouseEventPos.y + windowDimensions.height);
+		tagEvent(mouseMoveEventTime);
 	};
 
 
@@ -316,6 +597,7 @@ void InputHandler::initKeyboardListener()
 	{
 		//Set the appropriate key to be considered pressed
 		keyboardStates[(int)keyCode] = InputState::Pressed;
+		tagEvent(keyboardEventTimes[(int)keyCode]);
 
 		//Exit if the escape key was pressed and the flag is set to true
 		if (exitOnEscape && keyCode == KeyCode::KEY_ESCAPE)
@@ -328,6 +610,7 @@ void InputHandler::initKeyboardListener()
 	{
 		//Set the appropriate key to be considered released
 		keyboardStates[(int)keyCode] = InputState::Released;
+		tagEvent(keyboardEventTimes[(int)keyCode]);
 	};
 
 
@@ -337,6 +620,119 @@ void InputHandler::initKeyboardListener()
 
 
 
+bool InputHandler::initGLFWPolling()
+{
+#if INPUT_HAS_GLFW
+	//Get the GLFW window from the Cocos2D window. If there isn't one, polling can't be used
+	GLViewImpl* glview = dynamic_cast<GLViewImpl*>(Director::getInstance()->getOpenGLView());
+
+	if (!glview || !glview->getWindow())
+		return false;
+
+	glfwWindow = glview->getWindow();
+
+	//Build the list of keys to poll. Start with the ones that are in a continuous range
+	glfwKeyMappings.clear();
+
+	for (int i = 0; i < 26; i++)
+		glfwKeyMappings.push_back({ GLFW_KEY_A + i, (KeyCode)((int)KeyCode::KEY_A + i) });
+
+	for (int i = 0; i < 10; i++)
+	{
+		glfwKeyMappings.push_back({ GLFW_KEY_0 + i, (KeyCode)((int)KeyCode::KEY_0 + i) });
+		glfwKeyMappings.push_back({ GLFW_KEY_KP_0 + i, (KeyCode)((int)KeyCode::KEY_0 + i) });
+	}
+
+	for (int i = 0; i < 12; i++)
+		glfwKeyMappings.push_back({ GLFW_KEY_F1 + i, (KeyCode)((int)KeyCode::KEY_F1 + i) });
+
+	//Then add all of the other keys
+	for (const GLFWKeyMapping& mapping : GLFW_KEY_MAP)
+		glfwKeyMappings.push_back(mapping);
+
+	//Take over the scroll callback, keeping Cocos2D's so it can still be called
+	previousScrollCallback = glfwSetScrollCallback(glfwWindow, onGLFWScroll);
+
+	//Poll at the start of every frame, before any scene's update() runs. Lower priorities run first
+	Director::getInstance()->getScheduler()->scheduleUpdate(this, -1000, false);
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+void InputHandler::setKeyDown(int keyIndex, bool isDown)
+{
+	InputState& state = keyboardStates[keyIndex];
+
+	//A key that just went down is pressed. A key that just came up is released. Otherwise nothing changed
+	if (isDown && (state == InputState::Idle || state == InputState::Released))
+	{
+		state = InputState::Pressed;
+		tagEvent(keyboardEventTimes[keyIndex]);
+
+		//Exit if the escape key was pressed and the flag is set to true
+		if (exitOnEscape && keyIndex == (int)KeyCode::KEY_ESCAPE)
+			Director::getInstance()->end();
+	}
+	else if (!isDown && (state == InputState::Pressed || state == InputState::Held))
+	{
+		state = InputState::Released;
+		tagEvent(keyboardEventTimes[keyIndex]);
+	}
+}
+
+void InputHandler::setMouseButtonDown(int buttonIndex, bool isDown)
+{
+	InputState& state = mouseStates[buttonIndex];
+
+	//Same as the keys. Only change the state when the button goes down or comes up
+	if (isDown && (state == InputState::Idle || state == InputState::Released))
+	{
+		state = InputState::Pressed;
+		tagEvent(mouseEventTimes[buttonIndex]);
+	}
+	else if (!isDown && (state == InputState::Pressed || state == InputState::Held))
+	{
+		state = InputState::Released;
+		tagEvent(mouseEventTimes[buttonIndex]);
+	}
+}
+
+void InputHandler::onGLFWScroll(GLFWwindow* window, double x, double y)
+{
+#if INPUT_HAS_GLFW
+	//Match the signs of the values that come from the event dispatcher so getMouseScroll() works the same with both backends
+	INPUTS->scrollValue = -(float)y;
+	INPUTS->horizontalScrollValue = (float)x;
+
+	//Let Cocos2D handle the scroll as well so nothing else breaks
+	if (previousScrollCallback)
+		previousScrollCallback(window, x, y);
+#endif
+}
+
+void InputHandler::tagEvent(long long& eventTime)
+{
+	//Only timestamp events while latency is being measured. Otherwise the time stays at 0 and markRead() does nothing
+	//If an earlier event on the same input this frame hasn't been read yet, keep the older time since that is the one the player has been waiting on. Unread times are cleared in clearForNextFrame()
+	if (LATENCY->isEnabled() && eventTime == 0)
+		eventTime = LatencyTracker::now();
+}
+
+void InputHandler::markRead(long long& eventTime) const
+{
+	//Only the first read of an event counts. Clear the time so later reads of the same event are ignored
+	if (eventTime == 0 || !LATENCY->isEnabled())
+		return;
+
+	LATENCY->recordRead(eventTime);
+	eventTime = 0;
+}
+
+
+
 //--- Singleton Instance ---//
 InputHandler* InputHandler::getInstance()
 {
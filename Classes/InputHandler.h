@@ -13,6 +13,10 @@
 		- Also special 'anyButton' events
 			> Same as mouse and keyboard but checks for ANY key and ANY mouse
 			> Useful for splash screens and other similar systems where you just want the player to press ANYTHING before they move on
+		- Two backends are available, chosen when calling init()
+			> InputBackend::EventDispatcher goes through Cocos2D's event listeners. This is the default
+			> InputBackend::GLFWPolling reads the keyboard and mouse straight from the window once per frame, skipping the event dispatcher entirely. The getters work exactly the same
+		- Every event is timestamped while LATENCY-> is enabled so the time from input to screen can be measured (see LatencyTracker.h)
 
 	Usage:
 		- You are free to use this class for the case studies and for GDW
@@ -59,11 +63,56 @@ enum InputState
 	Held
 };
 
+/*
+	Input Backend Enum
+	- Used to pick where the input handler gets its inputs from. Passed into init()
+
+	> EventDispatcher
+		- Inputs come from Cocos2D's event listeners. Every event goes through the event dispatcher before it reaches us
+	> GLFWPolling
+		- Inputs are read straight from the GLFW window once per frame, before any scene's update() is called. Skips the event dispatcher completely
+		- Only works on Windows, Mac and Linux. Falls back to EventDispatcher anywhere else
+*/
+enum class InputBackend
+{
+	EventDispatcher,
+	GLFWPolling
+};
+
 //Useful shorthands
 #define NUM_MOUSE_BUTTONS (int)cocos2d::EventMouse::MouseButton::BUTTON_8 + 2 //The number of mouse buttons supported by Cocos2D.
 #define NUM_KEY_CODES (int)cocos2d::EventKeyboard::KeyCode::KEY_PLAY + 1  //The number of keys supported by Cocos2D.
 typedef cocos2d::EventKeyboard::KeyCode KeyCode; //A shortcut for accessing KeyCodes
 typedef cocos2d::EventMouse::MouseButton MouseButton; //A shortcut for accessing MouseButtons
+struct GLFWwindow; //The window type used by the GLFW polling backend
+
+/*
+	Input Snapshot Struct
+	- A copy of every key, mouse button, the mouse position and the scroll wheel on one frame
+	- It is plain data with no pointers, so it can be copied with memcpy, compared with memcmp or sent over the network as is
+	- Used by the rollback manager to record and replay inputs (see RollbackManager.h), but it can also be used to read another player's inputs with the same getters as INPUTS->
+*/
+struct InputSnapshot
+{
+	unsigned int frameNumber; //The input frame the snapshot was taken on
+	float mouseX, mouseY; //The position of the mouse, from the BOTTOM LEFT
+	float scrollValue, horizontalScrollValue; //The scroll wheel values. Stored the same way as in the input handler
+	InputState mouseStates[NUM_MOUSE_BUTTONS]; //The state of every mouse button
+	InputState keyboardStates[NUM_KEY_CODES]; //The state of every key
+
+	InputSnapshot(); //Starts with nothing pressed
+
+	//Work the same as the input handler's getters
+	Vec2 getMousePosition() const;
+	bool getMouseButtonPress(MouseButton button) const;
+	bool getMouseButtonRelease(MouseButton button) const;
+	bool getMouseButton(MouseButton button) const;
+	bool getKeyPress(KeyCode key) const;
+	bool getKeyRelease(KeyCode key) const;
+	bool getKey(KeyCode key) const;
+
+	void clearForNextFrame(); //Moves pressed to held and released to idle, the same as the input handler does at the end of a frame. Used to guess the next frame's inputs
+};
 
 
 
@@ -76,6 +125,8 @@ typedef cocos2d::EventMouse::MouseButton MouseButton; //A shortcut for accessing
 		- Get mouse button press / release / hold events
 		- Get key press / release / hold events
 		- Get any key or button press / release / hold events
+		- Get the frame number
+		- Save / load the input state
 	> Methods
 		- Init
 		- Clear inputs for the next frame
@@ -199,6 +250,31 @@ public:
 	bool getAnyButton() const;
 
 
+	//Frames
+	/*
+		Get the number of the current input frame. It counts up by 1 every time clearForNextFrame() is called, so every press and release happens on exactly one frame number
+
+		@return Returns -> The current frame number. Starts at 0
+	*/
+	unsigned int getFrameNumber() const;
+
+
+	//Snapshots
+	/*
+		Copy the current state of every input into a snapshot. This is fast enough to do every frame
+
+		@param Snapshot -> Where the inputs are copied to
+	*/
+	void saveState(InputSnapshot& snapshot) const;
+
+	/*
+		Overwrite the current state of every input with a snapshot. Everything that reads INPUTS-> afterwards will see the inputs from the snapshot's frame
+
+		@param Snapshot -> The inputs to load. Usually made with saveState()
+	*/
+	void loadState(const InputSnapshot& snapshot);
+
+
 
 	//--- Methods ---//
 	/*
@@ -208,6 +284,21 @@ public:
 	*/
 	bool init();
 
+	/*
+		Same as init() but lets you pick where the inputs come from. This HAS to be called ONCE instead of init()
+
+		@param Backend -> Where the inputs are read from. Ex: init(InputBackend::GLFWPolling) to read the window directly and skip the event dispatcher
+		@return Returns -> True if the init succeeded. False if not. Use to ensure everything was set up properly and throw and error if not.
+	*/
+	bool init(InputBackend backend);
+
+	/*
+		Only used by the GLFWPolling backend. Reads the keyboard and mouse from the window. This is called automatically at the start of every frame so you don't need to call it yourself
+
+		@param DeltaTime -> The time since the last frame. Unused
+	*/
+	virtual void update(float deltaTime) override;
+
 	/*
 		This HAS to be called EVERY FRAME at the END OF THE FRAME! If not, the inputs won't be synced to the current frame! Gets ready for the next frame of input handling.
 	*/
@@ -228,6 +319,8 @@ private:
 	//Cocos Engine
 	Size windowDimensions; //The size of the window created at the start of the game. Only used to ensure the mouse position's y-coordinate is flipped properly
 	bool exitOnEscape; //If true, the program will exit when escape is pressed. This is the default
+	InputBackend inputBackend; //Where the inputs are coming from. Set in init()
+	unsigned int frameNumber; //Counts up every time clearForNextFrame() is called
 
 	//Mouse
 	Vec2 mousePosition; //The current position of the mouse, stored as a Vec2. Updated every time the mouse is moved.
@@ -240,9 +333,20 @@ private:
 	InputState keyboardStates[NUM_KEY_CODES]; //States for all of the keycodes in cocos2D
 	EventListenerKeyboard* keyboardListener; //The listener for the keyboard events
 
+	//Latency
+	mutable long long mouseEventTimes[NUM_MOUSE_BUTTONS]; //When each mouse button last changed. Only set while latency is being measured and cleared back to 0 once gameplay reads it or the frame ends
+	mutable long long mouseMoveEventTime; //When the mouse last moved. Works the same as the mouse button times
+	mutable long long keyboardEventTimes[NUM_KEY_CODES]; //When each key last changed. Works the same as the mouse button times
+
 	//--- Utility Functions ---//
 	void initMouseListener(); //Set up the mouse event handling through the listener
 	void initKeyboardListener(); //Set up the keyboard event handling through the listener
+	void tagEvent(long long& eventTime); //Timestamps an input event if latency is being measured
+	void markRead(long long& eventTime) const; //Tells the latency tracker an input was read for the first time
+	bool initGLFWPolling(); //Set up the GLFW polling backend. Returns false if there isn't a GLFW window to read from
+	void setKeyDown(int keyIndex, bool isDown); //Updates a key's state from the polled value. Only used by the GLFW polling backend
+	void setMouseButtonDown(int buttonIndex, bool isDown); //Updates a mouse button's state from the polled value. Only used by the GLFW polling backend
+	static void onGLFWScroll(GLFWwindow* window, double x, double y); //Scrolling can't be polled so the GLFW polling backend reads it with a direct GLFW callback instead
 
 	//--- Singleton Instance ---//
 	static InputHandler* inst; //The singleton instance. Ie: The only instance of this class that can ever exist
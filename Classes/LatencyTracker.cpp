@@ -0,0 +1,248 @@
+#include "LatencyTracker.h"
+#include "DisplayHandler.h"
+
+//Core Libraries
+#include <chrono>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+//--- Static Variables ---//
+LatencyTracker* LatencyTracker::inst = nullptr;
+
+//--- Constants ---//
+static const double BUCKET_WIDTH_MS = 0.1; //The width of each histogram bucket in milliseconds
+static const unsigned int NUM_BUCKETS = 5000; //The number of buckets. 5000 buckets of 0.1ms covers up to half a second
+static const std::string OVERLAY_UPDATE_KEY = "LatencyTracker_Overlay"; //The scheduler key used by the overlay
+
+
+
+//--- Latency Histogram ---//
+LatencyHistogram::LatencyHistogram()
+	: buckets(NUM_BUCKETS, 0)
+{
+	sampleCount = 0;
+	maxSample = 0.0;
+}
+
+void LatencyHistogram::addSample(double milliseconds)
+{
+	//Find the bucket the sample falls into. Anything too big goes into the last bucket
+	unsigned int bucket = (milliseconds <= 0.0) ? 0 : (unsigned int)(milliseconds / BUCKET_WIDTH_MS);
+
+	if (bucket >= NUM_BUCKETS)
+		bucket = NUM_BUCKETS - 1;
+
+	buckets[bucket]++;
+	sampleCount++;
+
+	if (milliseconds > maxSample)
+		maxSample = milliseconds;
+}
+
+double LatencyHistogram::getPercentile(double percentile) const
+{
+	//No samples means no latency
+	if (sampleCount == 0)
+		return 0.0;
+
+	//Walk through the buckets until enough samples have been passed. The middle of that bucket is the answer
+	unsigned int target = (unsigned int)(percentile * sampleCount);
+	unsigned int total = 0;
+
+	for (unsigned int i = 0; i < NUM_BUCKETS; i++)
+	{
+		total += buckets[i];
+
+		if (total > target)
+			return (i + 0.5) * BUCKET_WIDTH_MS;
+	}
+
+	return maxSample;
+}
+
+unsigned int LatencyHistogram::getSampleCount() const
+{
+	return sampleCount;
+}
+
+double LatencyHistogram::getMax() const
+{
+	return maxSample;
+}
+
+void LatencyHistogram::reset()
+{
+	std::fill(buckets.begin(), buckets.end(), 0);
+	sampleCount = 0;
+	maxSample = 0.0;
+}
+
+void LatencyHistogram::write(std::ostream& output) const
+{
+	//Skip the empty buckets so the file stays readable
+	for (unsigned int i = 0; i < NUM_BUCKETS; i++)
+	{
+		if (buckets[i] > 0)
+			output << i * BUCKET_WIDTH_MS << "ms\t" << buckets[i] << "\n";
+	}
+}
+
+
+
+//--- Constructor and Destructor ---//
+LatencyTracker::LatencyTracker()
+{
+	//Measuring is off until it is turned on
+	enabled = false;
+	presentCallbackAdded = false;
+}
+
+LatencyTracker::~LatencyTracker()
+{
+	//Delete the singleton instance
+	if (inst)
+		delete inst;
+
+	//Clean up the pointer
+	inst = nullptr;
+}
+
+
+
+//--- Setters ---//
+void LatencyTracker::setEnabled(bool _enabled)
+{
+	//Save what was measured when it is turned off so the numbers aren't lost
+	if (enabled && !_enabled)
+		saveReport();
+
+	enabled = _enabled;
+	pendingEventTimes.clear();
+
+	//Get the display to tell us every time a frame is on screen. This only needs to be set up once
+	if (enabled && !presentCallbackAdded)
+	{
+		DISPLAY->addPresentCallback([this]()
+		{
+			if (enabled)
+				recordPresent();
+		});
+
+		presentCallbackAdded = true;
+	}
+}
+
+
+
+//--- Getters ---//
+bool LatencyTracker::isEnabled() const
+{
+	return enabled;
+}
+
+const LatencyHistogram& LatencyTracker::getInputToPresent() const
+{
+	return inputToPresent;
+}
+
+const LatencyHistogram& LatencyTracker::getInputToRead() const
+{
+	return inputToRead;
+}
+
+
+
+//--- Methods ---//
+long long LatencyTracker::now()
+{
+	//The steady clock never jumps backwards so it is safe for measuring time differences
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void LatencyTracker::recordRead(long long eventTime)
+{
+	//Nothing is recorded while latency isn't being measured
+	if (!enabled)
+		return;
+
+	//Record how long the input waited to be read, then hold on to it until the frame is on screen
+	inputToRead.addSample((now() - eventTime) / 1000000.0);
+	pendingEventTimes.push_back(eventTime);
+}
+
+void LatencyTracker::recordPresent()
+{
+	//Every input read this frame is now visible to the player
+	long long presentTime = now();
+
+	for (unsigned int i = 0; i < pendingEventTimes.size(); i++)
+		inputToPresent.addSample((presentTime - pendingEventTimes[i]) / 1000000.0);
+
+	pendingEventTimes.clear();
+}
+
+void LatencyTracker::reset()
+{
+	inputToPresent.reset();
+	inputToRead.reset();
+	pendingEventTimes.clear();
+}
+
+Node* LatencyTracker::createOverlay()
+{
+	//Put the label in the bottom left so it doesn't cover the other overlays
+	Label* overlay = Label::createWithSystemFont("", "Arial", 10.0f);
+	overlay->setAnchorPoint(Vec2(0.0f, 0.0f));
+	overlay->setPosition(Vec2(4.0f, 4.0f));
+	overlay->setTextColor(Color4B::GREEN);
+
+	//Rebuild the text twice a second
+	overlay->schedule([this, overlay](float deltaTime)
+	{
+		std::stringstream text;
+		text << std::fixed << std::setprecision(1);
+		text << "Input -> Screen  p50 " << inputToPresent.getPercentile(0.5) << "  p95 " << inputToPresent.getPercentile(0.95) << "  p99 " << inputToPresent.getPercentile(0.99) << " ms  (" << inputToPresent.getSampleCount() << ")\n";
+		text << "Input -> Read    p50 " << inputToRead.getPercentile(0.5) << "  p95 " << inputToRead.getPercentile(0.95) << "  p99 " << inputToRead.getPercentile(0.99) << " ms";
+
+		overlay->setString(text.str());
+	}, 0.5f, OVERLAY_UPDATE_KEY);
+
+	return overlay;
+}
+
+bool LatencyTracker::saveReport(const std::string& fileName) const
+{
+	//Open the report file in the writable path
+	std::ofstream file(FileUtils::getInstance()->getWritablePath() + fileName);
+
+	if (!file.is_open())
+		return false;
+
+	//Write the summary first, then the full histograms
+	file << std::fixed << std::setprecision(2);
+	file << "Input -> Screen: " << inputToPresent.getSampleCount() << " samples, p50 " << inputToPresent.getPercentile(0.5) << " ms, p95 " << inputToPresent.getPercentile(0.95) << " ms, p99 " << inputToPresent.getPercentile(0.99) << " ms, max " << inputToPresent.getMax() << " ms\n";
+	file << "Input -> Read: " << inputToRead.getSampleCount() << " samples, p50 " << inputToRead.getPercentile(0.5) << " ms, p95 " << inputToRead.getPercentile(0.95) << " ms, p99 " << inputToRead.getPercentile(0.99) << " ms, max " << inputToRead.getMax() << " ms\n";
+
+	file << "\n--- Input -> Screen Histogram ---\n";
+	inputToPresent.write(file);
+
+	file << "\n--- Input -> Read Histogram ---\n";
+	inputToRead.write(file);
+
+	return true;
+}
+
+
+
+//--- Singleton Instance ---//
+LatencyTracker* LatencyTracker::getInstance()
+{
+	//Create the singleton instance if it hasn't already been created
+	if (!inst)
+		inst = new LatencyTracker();
+
+	//Return the singleton instance
+	return inst;
+}
@@ -0,0 +1,181 @@
+/*
+============================================================
+	Latency Tracker:
+		- Measures how long it takes for an input to show up on screen
+			> Each key, mouse button and mouse move event is timestamped when the InputHandler receives it
+			> The first time gameplay reads that input (ex: INPUTS->getKeyPress()) the read time is recorded
+			> When the frame that read it is swapped onto the screen, the total latency is recorded
+		- Call setEnabled(true) to start measuring. It is off by default and costs almost nothing while off
+		- Call createOverlay() and add the result to a scene to see the p50 / p95 / p99 latencies on screen
+		- Call saveReport() to write the full histograms to a file. The report is also saved automatically when measuring is turned off
+
+	Usage:
+		- You are free to use this class for the case studies and for GDW
+		- You are free to edit / overwrite any or all of this class
+			> It is simply here to make your life easier
+		- You must leave this comment block at the top of the header
+
+	Note:
+		- This class uses the Singleton design pattern
+			> Do not ever make more than one instance of this class in its current form
+			> You don't ever have to call the constructor for this class. Simply start using it and it will build itself
+			> There is a macro "LATENCY->" that provides a shortcut for getting the singleton instance
+		- The input timestamp is when Cocos2D hands us the event. Any delay inside the operating system before that point can't be seen from here
+============================================================
+*/
+
+#ifndef LATENCYTRACKER_H
+#define LATENCYTRACKER_H
+
+//Core Libraries
+#include <string>
+#include <vector>
+#include <ostream>
+
+//3rd Party Libraries
+#include "cocos2d.h"
+
+//Namespaces
+using namespace cocos2d;
+
+/*
+	Latency Histogram Class:
+	- Counts latencies into fixed size buckets so percentiles can be found without storing every sample
+	- Each bucket is 0.1ms wide. Anything over the last bucket is counted in the last bucket
+*/
+class LatencyHistogram
+{
+public:
+	//--- Constructor ---//
+	LatencyHistogram();
+
+	//--- Methods ---//
+	void addSample(double milliseconds); //Count a single latency
+	double getPercentile(double percentile) const; //Get the latency that the given percent of samples are under. Ex: getPercentile(0.95) for p95
+	unsigned int getSampleCount() const; //The number of samples added since the last reset
+	double getMax() const; //The highest latency added since the last reset
+	void reset(); //Clear all of the samples
+	void write(std::ostream& output) const; //Write every non-empty bucket, one per line
+
+private:
+	std::vector<unsigned int> buckets; //The number of samples that landed in each bucket
+	unsigned int sampleCount; //The total number of samples
+	double maxSample; //The highest sample seen
+};
+
+
+
+/*
+	Latency Tracker Class:
+	> Setters
+		- Enable / disable measuring
+	> Getters
+		- Get the histograms
+	> Methods
+		- Record input events, reads and presents (called by the InputHandler and the display)
+		- Create an overlay
+		- Save a report
+*/
+class LatencyTracker
+{
+protected:
+	//--- Constructor ---//
+	LatencyTracker(); //The constructor is protected so only one instance of this class can ever exist. This is called the singleton pattern.
+
+public:
+	//--- Destructor ---//
+	~LatencyTracker();
+
+
+
+	//--- Setters ---//
+	/*
+		Turn latency measuring on or off. Turning it off saves a report to the writable path
+
+		@param Enabled -> If true, every input is timed from when it arrives to when it is on screen
+	*/
+	void setEnabled(bool enabled);
+
+
+
+	//--- Getters ---//
+	/*
+		@return Returns -> True if latency is currently being measured
+	*/
+	bool isEnabled() const;
+
+	/*
+		@return Returns -> The histogram of the time from an input arriving to the frame that used it being on screen. This is the latency the player feels
+	*/
+	const LatencyHistogram& getInputToPresent() const;
+
+	/*
+		@return Returns -> The histogram of the time from an input arriving to gameplay reading it. Shows how long inputs wait for the next update
+	*/
+	const LatencyHistogram& getInputToRead() const;
+
+
+
+	//--- Methods ---//
+	/*
+		@return Returns -> The current time in nanoseconds from a high resolution clock. Used for all of the timestamps
+	*/
+	static long long now();
+
+	/*
+		Record that gameplay read an input. Called by the InputHandler the first time an input is read
+
+		@param EventTime -> The timestamp the input arrived at, from now()
+	*/
+	void recordRead(long long eventTime);
+
+	/*
+		Record that a frame was swapped onto the screen. Every input read since the last present is finished and added to the histograms
+	*/
+	void recordPresent();
+
+	/*
+		Clear all of the samples. Useful to start measuring fresh after changing a setting
+	*/
+	void reset();
+
+	/*
+		Create a label that shows the p50 / p95 / p99 latencies. It updates itself twice a second. Add it to your scene with addChild()
+
+		@return Returns -> The overlay as an autoreleased node
+	*/
+	Node* createOverlay();
+
+	/*
+		Write the percentiles and full histograms to a file
+
+		@param FileName (optional) -> The name of the file in the writable path. Defaulted to "input_latency.txt"
+		@return Returns -> True if the file was written
+	*/
+	bool saveReport(const std::string& fileName = "input_latency.txt") const;
+
+
+
+	//--- Singleton Instance ---//
+	/*
+		Get the instance of the singleton. You shouldn't ever need to call this directly since the macro (LATENCY->) automatically calls it
+
+		@return Returns -> The singleton instance of this class. This is the ONLY instance of this class so intrefacing HAS to be done through this instance.
+	*/
+	static LatencyTracker* getInstance();
+
+private:
+	//--- Private Data ---//
+	bool enabled; //True while measuring
+	bool presentCallbackAdded; //The display callback is only added the first time measuring is turned on
+	std::vector<long long> pendingEventTimes; //Inputs that were read this frame but haven't been shown on screen yet
+	LatencyHistogram inputToPresent; //Time from an input arriving to it being on screen
+	LatencyHistogram inputToRead; //Time from an input arriving to gameplay reading it
+
+	//--- Singleton Instance ---//
+	static LatencyTracker* inst; //The singleton instance of this class. Ie: the only instance that can ever exist
+};
+
+#define LATENCY LatencyTracker::getInstance() //Macro to make using the class easier. Automatically gets the singleton instance for you
+
+#endif
@@ -0,0 +1,474 @@
+#include "Logger.h"
+
+//Core Libraries
+#include <chrono>
+#include <algorithm>
+
+//--- Static Variables ---//
+Logger* Logger::inst = nullptr;
+
+//--- Constants ---//
+static const char* LEVEL_NAMES[] = { "TRACE", "DEBUG", "INFO ", "WARN ", "ERROR" }; //Printed in front of each message. Padded so the messages line up
+
+/*
+	Log Record Header Struct
+	- The start of every message in a buffer. The values follow right after it
+	- A size of 0 means the rest of the buffer is empty and the next message is back at the start
+*/
+struct LogRecordHeader
+{
+	uint32_t size; //The size of the whole message in bytes, rounded up to 8
+	uint8_t level; //The LogLevel
+	uint8_t argCount; //How many values follow
+	uint16_t padding; //Unused
+	const char* format; //The message text. Points at a string literal
+	long long time; //When it was logged in nanoseconds
+};
+
+/*
+	Log Ring Struct
+	- One thread's message buffer. Only that thread writes to it and only the logging thread reads from it, so no lock is needed
+	- head and tail count up forever. The position in the buffer is the count modulo the size
+*/
+struct Logger::LogRing
+{
+	unsigned char buffer[LOG_RING_BYTES]; //The messages
+	std::atomic<unsigned long long> head; //Where the next message will be written. Only changed by the owning thread
+	std::atomic<unsigned long long> tail; //Where the next message will be read. Only changed by the logging thread
+	unsigned long long pendingHead; //Where head moves to once the message being written is finished
+	std::atomic<unsigned int> droppedCount; //Messages thrown away because the buffer was full
+	std::atomic<bool> isOrphaned; //True once the owning thread has ended. The logging thread deletes the buffer once it is empty
+};
+
+/*
+	Log Ring Owner Struct
+	- Gives each thread its own buffer. Its destructor runs when the thread ends
+*/
+struct LogRingOwner
+{
+	Logger::LogRing* ring = nullptr;
+
+	~LogRingOwner()
+	{
+		if (ring)
+			ring->isOrphaned.store(true, std::memory_order_release);
+	}
+};
+
+static thread_local LogRingOwner threadRing; //This thread's buffer
+
+//Rounds a size up to the next multiple of 8 so every message header is lined up in memory
+static inline unsigned int alignSize(unsigned int size)
+{
+	return (size + 7) & ~7u;
+}
+
+
+
+//--- Constructor and Destructor ---//
+Logger::Logger()
+{
+	minLevel = LOG_LEVEL_TRACE;
+	consoleOutput = true;
+	file = nullptr;
+	isRunning = true;
+	drainCount = 0;
+	retiredDroppedCount = 0;
+	startTime = getTime();
+
+	//Start the logging thread
+	thread = std::thread(&Logger::run, this);
+}
+
+Logger::~Logger()
+{
+	shutdown();
+
+	//Delete the singleton instance
+	if (inst)
+		delete inst;
+
+	//Clean up the pointer
+	inst = nullptr;
+}
+
+
+
+//--- Setters ---//
+void Logger::setLevel(LogLevel level)
+{
+	minLevel.store((int)level, std::memory_order_relaxed);
+}
+
+void Logger::setConsoleOutput(bool isEnabled)
+{
+	consoleOutput.store(isEnabled, std::memory_order_relaxed);
+}
+
+bool Logger::setFileOutput(const std::string& filePath)
+{
+	std::lock_guard<std::mutex> lock(fileMutex);
+
+	if (file)
+	{
+		fclose(file);
+		file = nullptr;
+	}
+
+	if (filePath.empty())
+		return true;
+
+	file = fopen(filePath.c_str(), "w");
+	return file != nullptr;
+}
+
+
+
+//--- Getters ---//
+LogLevel Logger::getLevel() const
+{
+	return (LogLevel)minLevel.load(std::memory_order_relaxed);
+}
+
+unsigned int Logger::getDroppedCount() const
+{
+	std::lock_guard<std::mutex> lock(ringsMutex);
+	unsigned int droppedCount = retiredDroppedCount.load(std::memory_order_relaxed);
+
+	for (unsigned int i = 0; i < rings.size(); i++)
+		droppedCount += rings[i]->droppedCount.load(std::memory_order_relaxed);
+
+	return droppedCount;
+}
+
+
+
+//--- Methods ---//
+void Logger::flush()
+{
+	//If the logging thread has stopped, write everything from this thread instead
+	if (!isRunning.load())
+	{
+		drain();
+		return;
+	}
+
+	//Wait for two full passes. The first one might have already been halfway through when flush() was called
+	unsigned int startCount = drainCount.load();
+
+	while (drainCount.load() < startCount + 2)
+		std::this_thread::yield();
+}
+
+void Logger::shutdown()
+{
+	if (!isRunning.exchange(false))
+		return;
+
+	thread.join();
+
+	//Write anything that was logged while the thread was stopping
+	drain();
+
+	std::lock_guard<std::mutex> lock(fileMutex);
+
+	if (file)
+	{
+		fclose(file);
+		file = nullptr;
+	}
+}
+
+
+
+//--- Singleton Instance ---//
+Logger* Logger::getInstance()
+{
+	//Generate the singleton if it hasn't been created yet
+	if (!inst)
+		inst = new Logger();
+
+	//Return the singleton
+	return inst;
+}
+
+
+
+//--- Utility Functions ---//
+unsigned char* Logger::beginRecord(LogLevel level, const char* format, unsigned int argCount, unsigned int argsSize)
+{
+	LogRing* ring = getThreadRing();
+	unsigned int size = alignSize((unsigned int)sizeof(LogRecordHeader) + argsSize);
+
+	//A message bigger than half the buffer could never fit alongside anything else
+	if (size > LOG_RING_BYTES / 2)
+	{
+		ring->droppedCount.fetch_add(1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	//Messages are never split across the end of the buffer. If it doesn't fit before the end, skip to the start
+	unsigned long long head = ring->head.load(std::memory_order_relaxed);
+	unsigned int offset = (unsigned int)(head % LOG_RING_BYTES);
+	unsigned int skip = (offset + size > LOG_RING_BYTES) ? LOG_RING_BYTES - offset : 0;
+
+	//Check there is room. Never wait for it, just drop the message
+	unsigned long long used = head - ring->tail.load(std::memory_order_acquire);
+
+	if (used + skip + size > LOG_RING_BYTES)
+	{
+		ring->droppedCount.fetch_add(1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	//Leave a size of 0 at the end so the logging thread knows to skip to the start
+	if (skip > 0)
+	{
+		uint32_t wrapMarker = 0;
+		memcpy(ring->buffer + offset, &wrapMarker, sizeof(uint32_t));
+		offset = 0;
+	}
+
+	LogRecordHeader* header = (LogRecordHeader*)(ring->buffer + offset);
+	header->size = size;
+	header->level = (uint8_t)level;
+	header->argCount = (uint8_t)argCount;
+	header->padding = 0;
+	header->format = format;
+	header->time = getTime();
+
+	ring->pendingHead = head + skip + size;
+	return ring->buffer + offset + sizeof(LogRecordHeader);
+}
+
+void Logger::endRecord()
+{
+	//Release so the logging thread sees the whole message before it sees the new head
+	LogRing* ring = threadRing.ring;
+	ring->head.store(ring->pendingHead, std::memory_order_release);
+}
+
+Logger::LogRing* Logger::getThreadRing()
+{
+	if (!threadRing.ring)
+	{
+		LogRing* ring = new LogRing();
+		ring->head = 0;
+		ring->tail = 0;
+		ring->pendingHead = 0;
+		ring->droppedCount = 0;
+		ring->isOrphaned = false;
+
+		//The only lock a logging thread ever takes, and only the first time it logs
+		std::lock_guard<std::mutex> lock(ringsMutex);
+		rings.push_back(ring);
+		threadRing.ring = ring;
+	}
+
+	return threadRing.ring;
+}
+
+void Logger::run()
+{
+	while (isRunning.load())
+	{
+		bool hadMessages = drain();
+		drainCount.fetch_add(1);
+
+		//Nap when there is nothing to do. A message waits at most this long before it is written
+		if (!hadMessages)
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+	}
+}
+
+bool Logger::drain()
+{
+	//Copy the list of buffers so a thread logging for the first time never has to wait for the console
+	{
+		std::lock_guard<std::mutex> ringsLock(ringsMutex);
+		drainRings = rings;
+	}
+
+	std::lock_guard<std::mutex> fileLock(fileMutex);
+
+	bool writeToConsole = consoleOutput.load(std::memory_order_relaxed);
+	bool hadMessages = false;
+	static std::string line; //Reused so it doesn't allocate every message. Only ever used by one thread at a time because of the file lock
+
+	for (unsigned int i = 0; i < drainRings.size(); i++)
+	{
+		LogRing* ring = drainRings[i];
+		bool isOrphaned = ring->isOrphaned.load(std::memory_order_acquire);
+		unsigned long long tail = ring->tail.load(std::memory_order_relaxed);
+		unsigned long long head = ring->head.load(std::memory_order_acquire);
+
+		while (tail < head)
+		{
+			unsigned int offset = (unsigned int)(tail % LOG_RING_BYTES);
+			uint32_t size;
+			memcpy(&size, ring->buffer + offset, sizeof(uint32_t));
+
+			//The rest of the buffer was skipped
+			if (size == 0)
+			{
+				tail += LOG_RING_BYTES - offset;
+				continue;
+			}
+
+			line.clear();
+			formatRecord(ring->buffer + offset, line);
+
+			if (writeToConsole)
+				fwrite(line.data(), 1, line.size(), stdout);
+
+			if (file)
+				fwrite(line.data(), 1, line.size(), file);
+
+			tail += size;
+			hadMessages = true;
+		}
+
+		//Give the space back to the thread
+		ring->tail.store(tail, std::memory_order_release);
+
+		//The thread is gone and everything it logged has been written
+		if (isOrphaned)
+		{
+			//Keep its dropped count, otherwise getDroppedCount() would forget about it
+			std::lock_guard<std::mutex> ringsLock(ringsMutex);
+			retiredDroppedCount.fetch_add(ring->droppedCount.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			rings.erase(std::find(rings.begin(), rings.end(), ring));
+			delete ring;
+		}
+	}
+
+	if (hadMessages)
+	{
+		if (writeToConsole)
+			fflush(stdout);
+
+		if (file)
+			fflush(file);
+	}
+
+	return hadMessages;
+}
+
+void Logger::formatRecord(const unsigned char* record, std::string& line) const
+{
+	LogRecordHeader header;
+	memcpy(&header, record, sizeof(LogRecordHeader));
+	const unsigned char* args = record + sizeof(LogRecordHeader);
+	unsigned int argsLeft = header.argCount;
+
+	//Start with the time since startup and the level
+	char text[64];
+	snprintf(text, sizeof(text), "[%10.3f] %s ", (double)(header.time - startTime) / 1000000.0, LEVEL_NAMES[header.level]);
+	line += text;
+
+	//Copy the message across, swapping each {} for the next value
+	for (const char* c = header.format; *c; c++)
+	{
+		//{{ and }} are a single brace
+		if ((c[0] == '{' && c[1] == '{') || (c[0] == '}' && c[1] == '}'))
+		{
+			line += *c++;
+			continue;
+		}
+
+		const char* close = (*c == '{') ? strchr(c, '}') : nullptr;
+
+		if (!close || argsLeft == 0)
+		{
+			line += *c;
+			continue;
+		}
+
+		//Turn the part after the : into a printf format. Ex: {:10.2f} becomes %10.2f
+		std::string spec = "%";
+		char conversion = 0;
+
+		if (c[1] == ':')
+		{
+			for (const char* s = c + 2; s < close; s++)
+			{
+				if ((*s >= '0' && *s <= '9') || *s == '.' || *s == '-' || *s == '+')
+					spec += *s;
+				else
+					conversion = *s;
+			}
+		}
+
+		//Read the value back and print it
+		uint8_t type = *args++;
+
+		if (type == LOG_ARG_STRING)
+		{
+			uint32_t length;
+			memcpy(&length, args, 4);
+			std::string value((const char*)args + 4, length);
+			args += 4 + length;
+
+			spec += "s";
+			int needed = snprintf(nullptr, 0, spec.c_str(), value.c_str());
+			std::vector<char> buffer(needed + 1);
+			snprintf(buffer.data(), buffer.size(), spec.c_str(), value.c_str());
+			line += buffer.data();
+		}
+		else
+		{
+			unsigned long long bits;
+			memcpy(&bits, args, 8);
+			args += 8;
+
+			switch (type)
+			{
+			case LOG_ARG_INT:
+				spec += (conversion == 'x') ? "llx" : "lld";
+				snprintf(text, sizeof(text), spec.c_str(), (long long)bits);
+				break;
+
+			case LOG_ARG_UINT:
+				spec += (conversion == 'x') ? "llx" : "llu";
+				snprintf(text, sizeof(text), spec.c_str(), bits);
+				break;
+
+			case LOG_ARG_DOUBLE:
+			{
+				double value;
+				memcpy(&value, &bits, 8);
+				spec += (conversion == 'f' || conversion == 'e' || conversion == 'g') ? conversion : 'g';
+				snprintf(text, sizeof(text), spec.c_str(), value);
+				break;
+			}
+
+			case LOG_ARG_BOOL:
+				spec += "s";
+				snprintf(text, sizeof(text), spec.c_str(), bits ? "true" : "false");
+				break;
+
+			case LOG_ARG_CHAR:
+				spec += "c";
+				snprintf(text, sizeof(text), spec.c_str(), (int)(char)bits);
+				break;
+
+			case LOG_ARG_POINTER:
+				spec += "p";
+				snprintf(text, sizeof(text), spec.c_str(), (void*)(uintptr_t)bits);
+				break;
+			}
+
+			line += text;
+		}
+
+		argsLeft--;
+		c = close;
+	}
+
+	line += '\n';
+}
+
+long long Logger::getTime()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
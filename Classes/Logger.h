@@ -0,0 +1,309 @@
+/*
+============================================================
+	Logger:
+		- A replacement for std::cout that doesn't slow down the game
+			> std::cout << ... << std::endl writes and flushes the console on every line. On Windows the console window is VERY slow, so a few lines a frame can cost milliseconds
+			> Instead, each message is copied into a buffer that belongs to the thread that logged it, and a separate logging thread turns them into text and writes them out
+			> Logging a message only costs a memory copy. It never waits on the console, the disk or a lock, so it is safe to log every frame
+		- Log with the macros, using {} wherever a value should go
+			> Ex: LOG_INFO("Loaded {} in {} ms", fileName, loadTime);
+			> Ex: LOG_WARNING("Only {:.1f} fps", fps); //Like printf, {:.1f} is 1 decimal place and {:10} is a width of 10
+			> The levels from least to most important are LOG_TRACE, LOG_DEBUG, LOG_INFO, LOG_WARNING and LOG_ERROR
+		- The messages go to the console, a file or both
+			> Ex: LOGGER->setFileOutput(FileUtils::getInstance()->getWritablePath() + "log.txt");
+		- Levels below LOG_MIN_LEVEL are removed when compiling, so they cost nothing at all. By default, that is LOG_LEVEL_DEBUG in debug builds and LOG_LEVEL_INFO in release builds
+			> Define LOG_MIN_LEVEL before including this file (or in the project settings) to change it. Ex: #define LOG_MIN_LEVEL LOG_LEVEL_WARNING
+			> setLevel() filters them again while the game is running
+
+	Usage:
+		- You are free to use this class for the case studies and for GDW
+		- You are free to edit / overwrite any or all of this class
+			> It is simply here to make your life easier
+		- You must leave this comment block at the top of the header
+
+	Note:
+		- This class uses the Singleton design pattern
+			> Do not ever make more than one instance of this class in its current form
+			> You don't ever have to call the constructor for this class. Simply start using it and it will build itself
+			> There is a macro "LOGGER->" that provides a shortcut for getting the singleton instance
+		- The message text MUST be a string literal ("like this"). Only a pointer to it is stored, the text is read later on the logging thread. The VALUES can be anything, strings are copied
+		- If a thread logs faster than the logging thread can write, the extra messages are dropped (and counted) instead of waiting
+============================================================
+*/
+
+#ifndef LOGGER_H
+#define LOGGER_H
+
+//Core Libraries
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <thread>
+
+//Log levels as numbers so they can be compared by the preprocessor
+#define LOG_LEVEL_TRACE 0
+#define LOG_LEVEL_DEBUG 1
+#define LOG_LEVEL_INFO 2
+#define LOG_LEVEL_WARNING 3
+#define LOG_LEVEL_ERROR 4
+#define LOG_LEVEL_OFF 5
+
+//The lowest level that is compiled in
+#ifndef LOG_MIN_LEVEL
+#if defined(_DEBUG) || (defined(COCOS2D_DEBUG) && COCOS2D_DEBUG > 0)
+#define LOG_MIN_LEVEL LOG_LEVEL_DEBUG
+#else
+#define LOG_MIN_LEVEL LOG_LEVEL_INFO
+#endif
+#endif
+
+//Useful shorthands
+#define LOG_RING_BYTES 65536 //The size of each thread's message buffer. Has to be a multiple of 8
+
+/*
+	Log Level Enum
+	- How important a message is
+*/
+enum class LogLevel
+{
+	Trace = LOG_LEVEL_TRACE, //Very detailed, usually only turned on to track down a bug
+	Debug = LOG_LEVEL_DEBUG, //Useful while developing
+	Info = LOG_LEVEL_INFO, //Normal events. Ex: a scene was loaded
+	Warning = LOG_LEVEL_WARNING, //Something is wrong but the game can keep going
+	Error = LOG_LEVEL_ERROR //Something failed
+};
+
+
+
+/*
+	Logger Class:
+	> Setters
+		- Set the level and where the messages go
+	> Getters
+		- Get the level
+		- Get the number of dropped messages
+	> Methods
+		- Log a message (use the LOG_ macros instead)
+		- Flush
+		- Shut down
+*/
+class Logger
+{
+protected:
+	//--- Constructor ---//
+	Logger(); //The constructor is protected so only one instance of this class can ever exist. This is called the singleton pattern.
+
+public:
+	//--- Destructor ---//
+	~Logger();
+
+
+
+	//--- Setters ---//
+	/*
+		Set the lowest level that is logged. Anything below it is thrown away right away. This can't bring back levels removed by LOG_MIN_LEVEL
+
+		@param Level -> The lowest level to log. Defaulted to LogLevel::Trace, so only LOG_MIN_LEVEL applies
+	*/
+	void setLevel(LogLevel level);
+
+	/*
+		Turn writing to the console (stdout) on or off
+
+		@param IsEnabled -> Defaulted to true
+	*/
+	void setConsoleOutput(bool isEnabled);
+
+	/*
+		Write every message to a file as well. The file is replaced each time the game runs
+
+		@param FilePath -> The file to write. An empty string stops writing to a file
+		@return Returns -> True if the file could be opened
+	*/
+	bool setFileOutput(const std::string& filePath);
+
+
+
+	//--- Getters ---//
+	/*
+		@return Returns -> The lowest level that is logged
+	*/
+	LogLevel getLevel() const;
+
+	/*
+		@return Returns -> How many messages have been dropped because a thread's buffer was full
+	*/
+	unsigned int getDroppedCount() const;
+
+
+
+	//--- Methods ---//
+	/*
+		Log a message. Use the LOG_ macros instead so the levels can be removed when compiling
+
+		@param Level -> How important the message is
+		@param Format -> The message. MUST be a string literal. Each {} is replaced by the next value
+		@param Args -> The values. Numbers, bools, chars, pointers, C strings and std::strings
+	*/
+	template<typename... Args>
+	void log(LogLevel level, const char* format, const Args&... args)
+	{
+		if ((int)level < minLevel.load(std::memory_order_relaxed))
+			return;
+
+		unsigned char* payload = beginRecord(level, format, (unsigned int)sizeof...(Args), getArgsSize(args...));
+
+		//The buffer was full
+		if (!payload)
+			return;
+
+		writeArgs(payload, args...);
+		endRecord();
+	}
+
+	/*
+		Wait until every message logged so far has been written. Call this before something that might crash, or before closing the game
+	*/
+	void flush();
+
+	/*
+		Write everything that is left and stop the logging thread. Messages logged afterwards are never written. Called automatically by the destructor
+	*/
+	void shutdown();
+
+
+
+	//--- Singleton Instance ---//
+	/*
+		Get the instance of the singleton. You shouldn't ever need to call this directly since the macro (LOGGER->) automatically calls it
+
+		@return Returns -> The singleton instance of this class. This is the ONLY instance of this class so intrefacing HAS to be done through this instance.
+	*/
+	static Logger* getInstance();
+
+private:
+	struct LogRing; //A thread's message buffer. Defined in Logger.cpp
+	friend struct LogRingOwner; //Hands each thread its buffer. Defined in Logger.cpp
+
+	/*
+		Log Arg Type Enum
+		- The type of a value stored in a message, so the logging thread knows how to read it back
+	*/
+	enum LogArgType : uint8_t
+	{
+		LOG_ARG_INT,
+		LOG_ARG_UINT,
+		LOG_ARG_DOUBLE,
+		LOG_ARG_BOOL,
+		LOG_ARG_CHAR,
+		LOG_ARG_POINTER,
+		LOG_ARG_STRING
+	};
+
+	//--- Private Data ---//
+	std::atomic<int> minLevel; //The lowest level that is logged
+	std::atomic<bool> consoleOutput; //True if messages are written to stdout
+	FILE* file; //The log file. nullptr if there isn't one
+	std::mutex fileMutex; //Stops the file from being swapped while the logging thread is writing to it
+
+	std::vector<LogRing*> rings; //Every thread's buffer
+	std::vector<LogRing*> drainRings; //A copy of rings used by the logging thread so it doesn't hold the lock while writing
+	mutable std::mutex ringsMutex; //Only locked when a thread logs for the first time, and briefly by the logging thread
+	std::thread thread; //The logging thread
+	std::atomic<bool> isRunning; //False once shutdown() is called
+	std::atomic<unsigned int> drainCount; //Counts up every time the logging thread has been through every buffer. Used by flush()
+	std::atomic<unsigned int> retiredDroppedCount; //Messages dropped by threads that have ended. Their buffers are deleted, so the counts are kept here
+	long long startTime; //When the logger was created in nanoseconds. Messages are timed from here
+
+	//--- Singleton Instance ---//
+	static Logger* inst; //The singleton instance of this class. Ie: the only instance that can ever exist
+
+	//--- Utility Functions ---//
+	unsigned char* beginRecord(LogLevel level, const char* format, unsigned int argCount, unsigned int argsSize); //Makes room in this thread's buffer and writes the message header. Returns where the values go, or nullptr if it is full
+	void endRecord(); //Makes the message visible to the logging thread
+	LogRing* getThreadRing(); //Gets this thread's buffer, creating it the first time
+	void run(); //The logging thread's loop
+	bool drain(); //Writes every waiting message. Returns true if there were any
+	void formatRecord(const unsigned char* record, std::string& line) const; //Turns a message back into text
+	static long long getTime(); //The current time in nanoseconds
+
+	//Working out how many bytes the values take up
+	static unsigned int getArgSize(bool) { return 1 + 8; }
+	static unsigned int getArgSize(char) { return 1 + 8; }
+	static unsigned int getArgSize(int) { return 1 + 8; }
+	static unsigned int getArgSize(long) { return 1 + 8; }
+	static unsigned int getArgSize(long long) { return 1 + 8; }
+	static unsigned int getArgSize(unsigned int) { return 1 + 8; }
+	static unsigned int getArgSize(unsigned long) { return 1 + 8; }
+	static unsigned int getArgSize(unsigned long long) { return 1 + 8; }
+	static unsigned int getArgSize(double) { return 1 + 8; }
+	static unsigned int getArgSize(const void*) { return 1 + 8; }
+	static unsigned int getArgSize(const char* value) { return 1 + 4 + (unsigned int)strlen(value ? value : ""); }
+	static unsigned int getArgSize(const std::string& value) { return 1 + 4 + (unsigned int)value.size(); }
+
+	static unsigned int getArgsSize() { return 0; }
+
+	template<typename T, typename... Rest>
+	static unsigned int getArgsSize(const T& arg, const Rest&... rest) { return getArgSize(arg) + getArgsSize(rest...); }
+
+	//Copying the values into the buffer. Every number is widened to 8 bytes so there are only a few types to read back
+	static void writeValue(unsigned char*& out, LogArgType type, const void* value) { *out++ = type; memcpy(out, value, 8); out += 8; }
+	static void writeString(unsigned char*& out, const char* value, uint32_t length) { *out++ = LOG_ARG_STRING; memcpy(out, &length, 4); memcpy(out + 4, value, length); out += 4 + length; }
+
+	static void writeArg(unsigned char*& out, bool value) { long long v = value; writeValue(out, LOG_ARG_BOOL, &v); }
+	static void writeArg(unsigned char*& out, char value) { long long v = value; writeValue(out, LOG_ARG_CHAR, &v); }
+	static void writeArg(unsigned char*& out, int value) { long long v = value; writeValue(out, LOG_ARG_INT, &v); }
+	static void writeArg(unsigned char*& out, long value) { long long v = value; writeValue(out, LOG_ARG_INT, &v); }
+	static void writeArg(unsigned char*& out, long long value) { writeValue(out, LOG_ARG_INT, &value); }
+	static void writeArg(unsigned char*& out, unsigned int value) { unsigned long long v = value; writeValue(out, LOG_ARG_UINT, &v); }
+	static void writeArg(unsigned char*& out, unsigned long value) { unsigned long long v = value; writeValue(out, LOG_ARG_UINT, &v); }
+	static void writeArg(unsigned char*& out, unsigned long long value) { writeValue(out, LOG_ARG_UINT, &value); }
+	static void writeArg(unsigned char*& out, double value) { writeValue(out, LOG_ARG_DOUBLE, &value); }
+	static void writeArg(unsigned char*& out, const void* value) { unsigned long long v = (unsigned long long)(uintptr_t)value; writeValue(out, LOG_ARG_POINTER, &v); }
+	static void writeArg(unsigned char*& out, const char* value) { value = value ? value : ""; writeString(out, value, (uint32_t)strlen(value)); }
+	static void writeArg(unsigned char*& out, const std::string& value) { writeString(out, value.data(), (uint32_t)value.size()); }
+
+	static void writeArgs(unsigned char*&) {}
+
+	template<typename T, typename... Rest>
+	static void writeArgs(unsigned char*& out, const T& arg, const Rest&... rest) { writeArg(out, arg); writeArgs(out, rest...); }
+};
+
+#define LOGGER Logger::getInstance() //Macro to make using the class easier. Automatically gets the singleton instance for you
+
+//The logging macros. The levels below LOG_MIN_LEVEL turn into nothing, so their values aren't even worked out
+#if LOG_MIN_LEVEL <= LOG_LEVEL_TRACE
+#define LOG_TRACE(...) LOGGER->log(LogLevel::Trace, __VA_ARGS__)
+#else
+#define LOG_TRACE(...) ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) LOGGER->log(LogLevel::Debug, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(...) LOGGER->log(LogLevel::Info, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= LOG_LEVEL_WARNING
+#define LOG_WARNING(...) LOGGER->log(LogLevel::Warning, __VA_ARGS__)
+#else
+#define LOG_WARNING(...) ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) LOGGER->log(LogLevel::Error, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,329 @@
+#include "ParticleEngine.h"
+#include "Logger.h"
+
+//Core Libraries
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+//SIMD Libraries
+#if PARTICLE_SIMD_AVX
+#include <immintrin.h>
+#elif PARTICLE_SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+//--- Constants ---//
+static const unsigned int SIMD_WIDTH = 8; //The array sizes are rounded up to this so every SIMD loop can run over whole groups. 8 covers both AVX and SSE
+static const unsigned int ARRAY_ALIGNMENT = 32; //The byte alignment of every array. AVX loads need 32
+static const unsigned int NUM_ARRAYS = 9; //The number of attribute arrays stored in the memory block
+static const float DEG_TO_RAD = 3.14159265f / 180.0f; //Converts degrees to radians
+
+
+
+//--- Particle Emitter Settings ---//
+ParticleEmitterSettings::ParticleEmitterSettings()
+{
+	//A white burst in every direction that fades out
+	x = 0.0f;
+	y = 0.0f;
+	angle = 90.0f;
+	spread = 180.0f;
+	minSpeed = 50.0f;
+	maxSpeed = 150.0f;
+	minLife = 0.5f;
+	maxLife = 1.5f;
+	minSize = 2.0f;
+	maxSize = 4.0f;
+
+	for (unsigned int i = 0; i < 4; i++)
+	{
+		startColor[i] = 255;
+		endColor[i] = (i == 3) ? 0 : 255;
+	}
+}
+
+
+
+//--- Constructors and Destructor ---//
+ParticleEngine::ParticleEngine(unsigned int _maxParticles)
+{
+	//Round the capacity up to a whole number of SIMD groups
+	maxParticles = (_maxParticles + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+	particleCount = 0;
+	gravityX = 0.0f;
+	gravityY = 0.0f;
+	randomState = 0x9E3779B9;
+
+	//Allocate every array in one block with enough extra room to align each of them
+	//The block is zeroed since integrate() works on whole SIMD groups, so it reads and writes the unused lanes past the last particle
+	size_t arrayBytes = ((size_t)maxParticles * sizeof(float) + ARRAY_ALIGNMENT - 1) / ARRAY_ALIGNMENT * ARRAY_ALIGNMENT;
+	memory = calloc(arrayBytes * NUM_ARRAYS + ARRAY_ALIGNMENT, 1);
+
+	//Out of memory. Leave the engine empty so emit() never adds anything and the caller can check getMaxParticles()
+	if (!memory)
+	{
+		LOG_ERROR("ParticleEngine: could not allocate room for {} particles", maxParticles);
+		maxParticles = 0;
+		posX = posY = velX = velY = age = invLife = size = nullptr;
+		startColor = endColor = nullptr;
+		return;
+	}
+
+	//Find the first aligned address in the block, then hand out the arrays one after another
+	uintptr_t address = ((uintptr_t)memory + ARRAY_ALIGNMENT - 1) & ~(uintptr_t)(ARRAY_ALIGNMENT - 1);
+	posX = (float*)(address);
+	posY = (float*)(address + arrayBytes);
+	velX = (float*)(address + arrayBytes * 2);
+	velY = (float*)(address + arrayBytes * 3);
+	age = (float*)(address + arrayBytes * 4);
+	invLife = (float*)(address + arrayBytes * 5);
+	size = (float*)(address + arrayBytes * 6);
+	startColor = (uint32_t*)(address + arrayBytes * 7);
+	endColor = (uint32_t*)(address + arrayBytes * 8);
+}
+
+ParticleEngine::~ParticleEngine()
+{
+	//All of the arrays are in the one block so only one free is needed
+	free(memory);
+	memory = nullptr;
+}
+
+
+
+//--- Setters ---//
+void ParticleEngine::setGravity(float x, float y)
+{
+	gravityX = x;
+	gravityY = y;
+}
+
+
+
+//--- Getters ---//
+unsigned int ParticleEngine::getParticleCount() const
+{
+	return particleCount;
+}
+
+unsigned int ParticleEngine::getMaxParticles() const
+{
+	return maxParticles;
+}
+
+const char* ParticleEngine::getSimdName()
+{
+#if PARTICLE_SIMD_AVX
+	return "AVX";
+#elif PARTICLE_SIMD_SSE
+	return "SSE";
+#else
+	return "Scalar";
+#endif
+}
+
+
+
+//--- Methods ---//
+unsigned int ParticleEngine::emit(unsigned int count, const ParticleEmitterSettings& settings)
+{
+	//Only spawn as many as there is room for
+	count = std::min(count, maxParticles - particleCount);
+
+	//Pack the colors once since every particle from this emit shares them
+	uint32_t packedStart = settings.startColor[0] | (settings.startColor[1] << 8) | (settings.startColor[2] << 16) | ((uint32_t)settings.startColor[3] << 24);
+	uint32_t packedEnd = settings.endColor[0] | (settings.endColor[1] << 8) | (settings.endColor[2] << 16) | ((uint32_t)settings.endColor[3] << 24);
+
+	for (unsigned int i = particleCount; i < particleCount + count; i++)
+	{
+		//Pick a random direction and speed inside the ranges
+		float direction = (settings.angle + randomRange(-settings.spread, settings.spread)) * DEG_TO_RAD;
+		float speed = randomRange(settings.minSpeed, settings.maxSpeed);
+
+		posX[i] = settings.x;
+		posY[i] = settings.y;
+		velX[i] = cosf(direction) * speed;
+		velY[i] = sinf(direction) * speed;
+		age[i] = 0.0f;
+		invLife[i] = 1.0f / randomRange(settings.minLife, settings.maxLife);
+		size[i] = randomRange(settings.minSize, settings.maxSize) * 0.5f;
+		startColor[i] = packedStart;
+		endColor[i] = packedEnd;
+	}
+
+	particleCount += count;
+	return count;
+}
+
+void ParticleEngine::update(float deltaTime)
+{
+	//Move everything first, then throw out the particles that died
+	integrate(deltaTime);
+	compact();
+}
+
+void ParticleEngine::writeQuads(ParticleVertex* vertices) const
+{
+	for (unsigned int i = 0; i < particleCount; i++)
+	{
+		//How far through its life the particle is, from 0 to 1
+		float t = std::min(age[i] * invLife[i], 1.0f);
+
+		//Blend each color channel from the start color to the end color
+		uint32_t start = startColor[i];
+		uint32_t end = endColor[i];
+		uint8_t r = (uint8_t)((start & 0xFF) + ((float)(end & 0xFF) - (float)(start & 0xFF)) * t);
+		uint8_t g = (uint8_t)(((start >> 8) & 0xFF) + ((float)((end >> 8) & 0xFF) - (float)((start >> 8) & 0xFF)) * t);
+		uint8_t b = (uint8_t)(((start >> 16) & 0xFF) + ((float)((end >> 16) & 0xFF) - (float)((start >> 16) & 0xFF)) * t);
+		uint8_t a = (uint8_t)((start >> 24) + ((float)(end >> 24) - (float)(start >> 24)) * t);
+
+		//Write the four corners. Bottom left, bottom right, top left, top right
+		float left = posX[i] - size[i];
+		float right = posX[i] + size[i];
+		float bottom = posY[i] - size[i];
+		float top = posY[i] + size[i];
+
+		ParticleVertex* quad = vertices + i * 4;
+		quad[0] = { left, bottom, 0.0f, r, g, b, a, 0.0f, 1.0f };
+		quad[1] = { right, bottom, 0.0f, r, g, b, a, 1.0f, 1.0f };
+		quad[2] = { left, top, 0.0f, r, g, b, a, 0.0f, 0.0f };
+		quad[3] = { right, top, 0.0f, r, g, b, a, 1.0f, 0.0f };
+	}
+}
+
+void ParticleEngine::clear()
+{
+	particleCount = 0;
+}
+
+double ParticleEngine::runBenchmark(unsigned int particleCount, unsigned int frames)
+{
+	//Set up a system that is kept full the whole time. Particles that die are replaced on the next frame
+	ParticleEngine engine(particleCount);
+	ParticleEmitterSettings settings;
+	engine.setGravity(0.0f, -98.0f);
+
+	std::vector<ParticleVertex> vertices((size_t)engine.getMaxParticles() * 4);
+	engine.emit(particleCount, settings);
+
+	//Time a fixed 60 fps worth of frames
+	auto startTime = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < frames; i++)
+	{
+		engine.emit(particleCount - engine.getParticleCount(), settings);
+		engine.update(1.0f / 60.0f);
+		engine.writeQuads(vertices.data());
+	}
+
+	double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+	double frameMs = totalMs / std::max(frames, 1u);
+
+	//Print the results
+	LOG_INFO("Particle benchmark ({}): {} particles, {} frames, {} ms per frame", getSimdName(), particleCount, frames, frameMs);
+
+	return frameMs;
+}
+
+
+
+//--- Utility Functions ---//
+float ParticleEngine::randomRange(float min, float max)
+{
+	//A xorshift random number generator. Much faster than rand() and good enough for particles
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 17;
+	randomState ^= randomState << 5;
+
+	//Use the top 24 bits to make a float from 0 to 1
+	return min + (max - min) * ((randomState >> 8) * (1.0f / 16777216.0f));
+}
+
+void ParticleEngine::integrate(float deltaTime)
+{
+	//The gravity only changes the velocity by this much each frame
+	float gravityStepX = gravityX * deltaTime;
+	float gravityStepY = gravityY * deltaTime;
+
+	//Round up to whole SIMD groups. The extra particles at the end are dead space so it doesn't matter what happens to them
+	unsigned int groupedCount = (particleCount + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+
+#if PARTICLE_SIMD_AVX
+
+	//8 particles at a time
+	__m256 dt = _mm256_set1_ps(deltaTime);
+	__m256 gx = _mm256_set1_ps(gravityStepX);
+	__m256 gy = _mm256_set1_ps(gravityStepY);
+
+	for (unsigned int i = 0; i < groupedCount; i += 8)
+	{
+		__m256 vx = _mm256_add_ps(_mm256_load_ps(velX + i), gx);
+		__m256 vy = _mm256_add_ps(_mm256_load_ps(velY + i), gy);
+		_mm256_store_ps(velX + i, vx);
+		_mm256_store_ps(velY + i, vy);
+		_mm256_store_ps(posX + i, _mm256_add_ps(_mm256_load_ps(posX + i), _mm256_mul_ps(vx, dt)));
+		_mm256_store_ps(posY + i, _mm256_add_ps(_mm256_load_ps(posY + i), _mm256_mul_ps(vy, dt)));
+		_mm256_store_ps(age + i, _mm256_add_ps(_mm256_load_ps(age + i), dt));
+	}
+
+#elif PARTICLE_SIMD_SSE
+
+	//4 particles at a time
+	__m128 dt = _mm_set1_ps(deltaTime);
+	__m128 gx = _mm_set1_ps(gravityStepX);
+	__m128 gy = _mm_set1_ps(gravityStepY);
+
+	for (unsigned int i = 0; i < groupedCount; i += 4)
+	{
+		__m128 vx = _mm_add_ps(_mm_load_ps(velX + i), gx);
+		__m128 vy = _mm_add_ps(_mm_load_ps(velY + i), gy);
+		_mm_store_ps(velX + i, vx);
+		_mm_store_ps(velY + i, vy);
+		_mm_store_ps(posX + i, _mm_add_ps(_mm_load_ps(posX + i), _mm_mul_ps(vx, dt)));
+		_mm_store_ps(posY + i, _mm_add_ps(_mm_load_ps(posY + i), _mm_mul_ps(vy, dt)));
+		_mm_store_ps(age + i, _mm_add_ps(_mm_load_ps(age + i), dt));
+	}
+
+#else
+
+	//One particle at a time. Written as simple loops so the compiler can still vectorize them if it is able to
+	for (unsigned int i = 0; i < groupedCount; i++)
+	{
+		velX[i] += gravityStepX;
+		velY[i] += gravityStepY;
+		posX[i] += velX[i] * deltaTime;
+		posY[i] += velY[i] * deltaTime;
+		age[i] += deltaTime;
+	}
+
+#endif
+}
+
+void ParticleEngine::compact()
+{
+	//Copy every particle down to the next free slot, but only move the slot forward if the particle is still alive
+	//Dead particles get overwritten by the next living one. There are no if statements so there is nothing for the CPU to mispredict
+	unsigned int writeIndex = 0;
+
+	for (unsigned int i = 0; i < particleCount; i++)
+	{
+		unsigned int isAlive = (age[i] * invLife[i] < 1.0f);
+
+		posX[writeIndex] = posX[i];
+		posY[writeIndex] = posY[i];
+		velX[writeIndex] = velX[i];
+		velY[writeIndex] = velY[i];
+		age[writeIndex] = age[i];
+		invLife[writeIndex] = invLife[i];
+		size[writeIndex] = size[i];
+		startColor[writeIndex] = startColor[i];
+		endColor[writeIndex] = endColor[i];
+
+		writeIndex += isAlive;
+	}
+
+	particleCount = writeIndex;
+}
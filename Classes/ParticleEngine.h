@@ -0,0 +1,185 @@
+/*
+============================================================
+	Particle Engine:
+		- A fast particle simulation that can handle hundreds of thousands of particles
+			> Every particle attribute (position, velocity, age...) is stored in its own array instead of one struct per particle. This is called "structure of arrays"
+			> The arrays are updated 8 (AVX) or 4 (SSE) particles at a time using SIMD instructions. If neither is available, a regular loop is used
+			> Dead particles are removed without any if statements so the CPU never has to guess which way a branch goes
+		- This class only does the simulation. It doesn't draw anything and doesn't need a window
+			> Use ParticleNode to draw the particles in a scene
+			> Use runBenchmark() to time the simulation without a window
+		- Call emit() to spawn particles and update() every frame to move them
+
+	Usage:
+		- You are free to use this class for the case studies and for GDW
+		- You are free to edit / overwrite any or all of this class
+			> It is simply here to make your life easier
+		- You must leave this comment block at the top of the header
+============================================================
+*/
+
+#ifndef PARTICLEENGINE_H
+#define PARTICLEENGINE_H
+
+//Core Libraries
+#include <cstdint>
+
+//Pick the widest SIMD instruction set the compiler is targeting. Defining PARTICLE_FORCE_SCALAR turns SIMD off completely, which is useful for comparing
+#if !defined(PARTICLE_FORCE_SCALAR) && defined(__AVX__)
+#define PARTICLE_SIMD_AVX 1
+#elif !defined(PARTICLE_FORCE_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define PARTICLE_SIMD_SSE 1
+#endif
+
+/*
+	Particle Emitter Settings Struct
+	- Describes how new particles are spawned. Passed into emit()
+	- Every range picks a random value between the min and max for each particle
+*/
+struct ParticleEmitterSettings
+{
+	float x, y; //Where the particles spawn
+	float angle, spread; //The direction the particles fly in and how far they can stray from it, both in degrees
+	float minSpeed, maxSpeed; //How fast the particles start out, in pixels per second
+	float minLife, maxLife; //How long the particles live, in seconds
+	float minSize, maxSize; //The width and height of each particle, in pixels
+	uint8_t startColor[4]; //The RGBA color particles have when they spawn
+	uint8_t endColor[4]; //The RGBA color particles fade to right before they die
+
+	ParticleEmitterSettings(); //Fills in some reasonable defaults. A white burst in every direction
+};
+
+/*
+	Particle Vertex Struct
+	- A single corner of a particle's quad. The layout matches Cocos2D's V3F_C4B_T2F exactly so it can be handed straight to the renderer
+*/
+struct ParticleVertex
+{
+	float x, y, z; //Position
+	uint8_t r, g, b, a; //Color
+	float u, v; //Texture coordinates
+};
+
+
+
+/*
+	Particle Engine Class:
+	> Setters
+		- Set gravity
+	> Getters
+		- Get the number of living particles and the maximum
+	> Methods
+		- Emit particles
+		- Update the simulation
+		- Write the particles out as quads
+		- Run a headless benchmark
+*/
+class ParticleEngine
+{
+public:
+	//--- Constructors and Destructor ---//
+	/*
+		@param MaxParticles -> The most particles that can be alive at once. All of the memory is allocated up front so nothing is allocated while the game is running
+	*/
+	ParticleEngine(unsigned int maxParticles);
+	~ParticleEngine();
+
+
+
+	//--- Setters ---//
+	/*
+		Set the acceleration applied to every particle every second. Ex: setGravity(0.0f, -98.0f) makes the particles fall
+
+		@param X -> Horizontal acceleration in pixels per second squared
+		@param Y -> Vertical acceleration in pixels per second squared
+	*/
+	void setGravity(float x, float y);
+
+
+
+	//--- Getters ---//
+	/*
+		@return Returns -> The number of particles currently alive
+	*/
+	unsigned int getParticleCount() const;
+
+	/*
+		@return Returns -> The most particles that can be alive at once. 0 if there wasn't enough memory for them
+	*/
+	unsigned int getMaxParticles() const;
+
+	/*
+		@return Returns -> The name of the SIMD instruction set being used. "AVX", "SSE" or "Scalar"
+	*/
+	static const char* getSimdName();
+
+
+
+	//--- Methods ---//
+	/*
+		Spawn new particles. If there isn't room for all of them, only as many as fit are spawned
+
+		@param Count -> The number of particles to spawn
+		@param Settings -> How the particles are spawned
+		@return Returns -> The number of particles that were actually spawned
+	*/
+	unsigned int emit(unsigned int count, const ParticleEmitterSettings& settings);
+
+	/*
+		Move every particle, age them and remove the ones that died. Call this once per frame
+
+		@param DeltaTime -> The time since the last frame in seconds
+	*/
+	void update(float deltaTime);
+
+	/*
+		Write every living particle out as a quad (4 vertices each) so it can be drawn. The color fades from the start color to the end color as the particle ages
+
+		@param Vertices -> Where the vertices are written. Must have room for getParticleCount() * 4 vertices
+	*/
+	void writeQuads(ParticleVertex* vertices) const;
+
+	/*
+		Remove every particle
+	*/
+	void clear();
+
+	/*
+		Time the simulation without a window. Spawns the particles, then updates them and writes their quads every frame. The results are printed to the console
+
+		@param ParticleCount -> The number of particles to simulate. Ex: 100000
+		@param Frames -> The number of frames to time
+		@return Returns -> The average time per frame in milliseconds
+	*/
+	static double runBenchmark(unsigned int particleCount, unsigned int frames);
+
+private:
+	//--- Private Data ---//
+	unsigned int maxParticles; //The most particles that can be alive. Rounded up to a multiple of 8 so the SIMD loops never need a leftover loop
+	unsigned int particleCount; //How many particles are alive
+	float gravityX, gravityY; //Acceleration applied to every particle
+	uint32_t randomState; //The state of the random number generator used when spawning
+
+	//The particle attributes. Each one is its own array, aligned to 32 bytes for the SIMD loads
+	void* memory; //The single block of memory all of the arrays live in
+	float* posX; //Horizontal positions
+	float* posY; //Vertical positions
+	float* velX; //Horizontal velocities
+	float* velY; //Vertical velocities
+	float* age; //How long each particle has been alive, in seconds
+	float* invLife; //1 divided by how long each particle lives. Multiplying by this is faster than dividing by the lifetime
+	float* size; //Half of the width of each particle
+	uint32_t* startColor; //The packed RGBA color at spawn
+	uint32_t* endColor; //The packed RGBA color at death
+
+	//--- Not Copyable ---//
+	ParticleEngine(const ParticleEngine&) = delete; //The engine owns its memory block so copying it would free the memory twice
+	ParticleEngine& operator=(const ParticleEngine&) = delete;
+
+	//--- Utility Functions ---//
+	float randomRange(float min, float max); //Returns a random float between min and max
+	void integrate(float deltaTime); //Moves and ages every particle using the widest SIMD available
+	void compact(); //Removes the dead particles without branching
+};
+
+#endif
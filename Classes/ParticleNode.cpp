@@ -0,0 +1,167 @@
+#include "ParticleNode.h"
+#include "ResourceHandler.h"
+
+//--- Constants ---//
+static const unsigned int PARTICLES_PER_BATCH = 16000; //The most particles in a single draw command. 4 vertices each has to stay under the 65536 limit of an unsigned short index
+
+//The engine writes its vertices straight into the Cocos2D vertex buffer, so the two vertex types have to be identical
+static_assert(sizeof(ParticleVertex) == sizeof(V3F_C4B_T2F), "ParticleVertex must have the same layout as V3F_C4B_T2F");
+
+
+
+//--- Creation ---//
+ParticleNode* ParticleNode::create(unsigned int maxParticles, const std::string& texturePath)
+{
+	//Same pattern as CREATE_FUNC, but with parameters
+	ParticleNode* node = new (std::nothrow) ParticleNode();
+	if (node && node->init(maxParticles, texturePath))
+	{
+		node->autorelease();
+		return node;
+	}
+
+	CC_SAFE_DELETE(node);
+	return nullptr;
+}
+
+
+
+//--- Constructor and Destructor ---//
+ParticleNode::ParticleNode()
+{
+	engine = nullptr;
+	texture = nullptr;
+	blendFunc = BlendFunc::ALPHA_PREMULTIPLIED;
+	emissionRate = 0.0f;
+	emissionAccumulator = 0.0f;
+}
+
+ParticleNode::~ParticleNode()
+{
+	//Clean up the engine and let go of the texture
+	delete engine;
+	engine = nullptr;
+
+	CC_SAFE_RELEASE_NULL(texture);
+}
+
+
+
+//--- Setters ---//
+void ParticleNode::setEmitter(const ParticleEmitterSettings& settings)
+{
+	emitter = settings;
+}
+
+void ParticleNode::setEmissionRate(float particlesPerSecond)
+{
+	emissionRate = particlesPerSecond;
+}
+
+void ParticleNode::setBlendFunc(const BlendFunc& _blendFunc)
+{
+	blendFunc = _blendFunc;
+}
+
+
+
+//--- Getters ---//
+ParticleEngine* ParticleNode::getEngine() const
+{
+	return engine;
+}
+
+
+
+//--- Methods ---//
+void ParticleNode::update(float deltaTime)
+{
+	//Spawn however many whole particles the emission rate adds up to, saving the leftover fraction for next frame
+	if (emissionRate > 0.0f)
+	{
+		emissionAccumulator += emissionRate * deltaTime;
+		unsigned int count = (unsigned int)emissionAccumulator;
+		emissionAccumulator -= count;
+
+		engine->emit(count, emitter);
+	}
+
+	//Move everything and remove the dead particles
+	engine->update(deltaTime);
+}
+
+void ParticleNode::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
+{
+	unsigned int particleCount = engine->getParticleCount();
+
+	if (particleCount == 0)
+		return;
+
+	//Have the engine write every particle straight into the vertex buffer
+	engine->writeQuads(reinterpret_cast<ParticleVertex*>(vertices.data()));
+
+	//Queue one draw command per batch. Every batch shares the same index buffer
+	unsigned int batchCount = (particleCount + PARTICLES_PER_BATCH - 1) / PARTICLES_PER_BATCH;
+
+	for (unsigned int i = 0; i < batchCount; i++)
+	{
+		unsigned int batchParticles = std::min(PARTICLES_PER_BATCH, particleCount - i * PARTICLES_PER_BATCH);
+
+		TrianglesCommand::Triangles triangles;
+		triangles.verts = vertices.data() + i * PARTICLES_PER_BATCH * 4;
+		triangles.vertCount = batchParticles * 4;
+		triangles.indices = indices.data();
+		triangles.indexCount = batchParticles * 6;
+
+		commands[i].init(_globalZOrder, texture->getName(), getGLProgramState(), blendFunc, triangles, transform, flags);
+		renderer->addCommand(&commands[i]);
+	}
+}
+
+bool ParticleNode::init(unsigned int maxParticles, const std::string& texturePath)
+{
+	//Ensure the parent class was init first
+	if (!Node::init())
+		return false;
+
+	//Load the texture through the resource handler so it is counted towards the memory budget
+	texture = RESOURCES->loadTexture(texturePath);
+
+	if (!texture)
+		return false;
+
+	texture->retain();
+	blendFunc = texture->hasPremultipliedAlpha() ? BlendFunc::ALPHA_PREMULTIPLIED : BlendFunc::ALPHA_NON_PREMULTIPLIED;
+
+	//Create the simulation and allocate everything up front so nothing is allocated during the game
+	engine = new ParticleEngine(maxParticles);
+
+	if (engine->getMaxParticles() == 0)
+		return false;
+
+	vertices.resize((size_t)engine->getMaxParticles() * 4);
+	commands.resize((engine->getMaxParticles() + PARTICLES_PER_BATCH - 1) / PARTICLES_PER_BATCH);
+
+	//Build the indices for one full batch. Each particle is two triangles: bottom left, bottom right, top left and top right, bottom left, top left
+	unsigned int batchParticles = std::min(PARTICLES_PER_BATCH, engine->getMaxParticles());
+	indices.resize(batchParticles * 6);
+
+	for (unsigned int i = 0; i < batchParticles; i++)
+	{
+		unsigned short corner = (unsigned short)(i * 4);
+		indices[i * 6 + 0] = corner;
+		indices[i * 6 + 1] = corner + 1;
+		indices[i * 6 + 2] = corner + 2;
+		indices[i * 6 + 3] = corner + 3;
+		indices[i * 6 + 4] = corner + 2;
+		indices[i * 6 + 5] = corner + 1;
+	}
+
+	//Use the same shader as sprites, which takes the vertices already in world space
+	setGLProgramState(GLProgramState::getOrCreateWithGLProgramName(GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR_NO_MVP));
+
+	//Allow for the update() function to be called by Cocos2D
+	this->scheduleUpdate();
+
+	return true;
+}
@@ -0,0 +1,112 @@
+/*
+============================================================
+	Particle Node:
+		- Draws a ParticleEngine in a scene. Add it to a scene like any other node
+			> Ex: ParticleNode* sparks = ParticleNode::create(100000, "CloseNormal.png"); this->addChild(sparks);
+		- Set the emitter settings and an emission rate to spawn particles continuously, or call getEngine()->emit() yourself for bursts
+		- The particles are drawn in large batches straight from the engine's output. There is no Sprite or Node per particle
+		- Positions are relative to the node, so moving the node moves every particle with it
+
+	Usage:
+		- You are free to use this class for the case studies and for GDW
+		- You are free to edit / overwrite any or all of this class
+			> It is simply here to make your life easier
+		- You must leave this comment block at the top of the header
+============================================================
+*/
+
+#ifndef PARTICLENODE_H
+#define PARTICLENODE_H
+
+//Core Libraries
+#include <string>
+#include <vector>
+
+//3rd Party Libraries
+#include "cocos2d.h"
+
+//Our Classes
+#include "ParticleEngine.h"
+
+//Namespaces
+using namespace cocos2d;
+
+/*
+	Particle Node Class:
+	> Setters
+		- Set the emitter settings
+		- Set the emission rate
+		- Set the blend function
+	> Getters
+		- Get the particle engine
+	> Methods
+		- Create
+		- Update / draw (called by Cocos2D)
+*/
+class ParticleNode : public Node
+{
+public:
+	//--- Creation ---//
+	/*
+		Create a particle node. It is an autoreleased object like everything else made with create()
+
+		@param MaxParticles -> The most particles that can be alive at once. Ex: 100000
+		@param TexturePath -> The image drawn for every particle. Ex: "CloseNormal.png"
+		@return Returns -> The new node, or nullptr if the texture couldn't be loaded
+	*/
+	static ParticleNode* create(unsigned int maxParticles, const std::string& texturePath);
+
+
+
+	//--- Setters ---//
+	/*
+		@param Settings -> How particles are spawned by the continuous emission. The position is relative to the node
+	*/
+	void setEmitter(const ParticleEmitterSettings& settings);
+
+	/*
+		@param ParticlesPerSecond -> How many particles are spawned every second. 0 turns the continuous emission off
+	*/
+	void setEmissionRate(float particlesPerSecond);
+
+	/*
+		@param BlendFunc -> How the particles are blended with what is behind them. Ex: BlendFunc::ADDITIVE for glowing sparks
+	*/
+	void setBlendFunc(const BlendFunc& blendFunc);
+
+
+
+	//--- Getters ---//
+	/*
+		@return Returns -> The particle engine doing the simulation. Use it to emit bursts, set gravity or check how many particles are alive
+	*/
+	ParticleEngine* getEngine() const;
+
+
+
+	//--- Methods ---//
+	virtual void update(float deltaTime) override; //Emits new particles and moves the existing ones. Called by Cocos2D every frame
+	virtual void draw(Renderer* renderer, const Mat4& transform, uint32_t flags) override; //Writes the particles into the vertex buffer and queues them to be drawn. Called by Cocos2D every frame
+
+protected:
+	//--- Constructor and Destructor ---//
+	ParticleNode(); //Use create() instead
+	virtual ~ParticleNode();
+
+	bool init(unsigned int maxParticles, const std::string& texturePath); //Sets up the engine, texture and index buffer. Called by create()
+
+private:
+	//--- Private Data ---//
+	ParticleEngine* engine; //The simulation
+	Texture2D* texture; //The image drawn for every particle. Retained so the resource handler never unloads it while it is being used
+	BlendFunc blendFunc; //How the particles are blended
+	ParticleEmitterSettings emitter; //Settings for the continuous emission
+	float emissionRate; //Particles per second for the continuous emission
+	float emissionAccumulator; //Leftover fractions of a particle from previous frames, so low emission rates still spawn the right amount
+
+	std::vector<V3F_C4B_T2F> vertices; //The vertex buffer the engine writes into. 4 vertices per particle
+	std::vector<unsigned short> indices; //The index buffer for a single batch. Every batch uses the same one since the indices are relative to the batch
+	std::vector<TrianglesCommand> commands; //One draw command per batch. The renderer can only handle so many vertices at once
+};
+
+#endif
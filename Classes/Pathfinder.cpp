@@ -0,0 +1,900 @@
+#include "Pathfinder.h"
+
+//Core Libraries
+#include <cmath>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+
+//--- Constants ---//
+static const int NEIGHBOUR_X[8] = { 1, -1, 0, 0, 1, -1, 1, -1 }; //The x offset of each of the 8 neighbours. The first 4 are straight, the last 4 are diagonal
+static const int NEIGHBOUR_Y[8] = { 0, 0, 1, -1, 1, 1, -1, -1 }; //The y offset of each of the 8 neighbours
+static const float DIAGONAL_COST = 1.41421356f; //The length of a diagonal step. Straight steps are 1
+static const float UNREACHABLE = std::numeric_limits<float>::infinity(); //The distance of cells that can't reach the goal
+static const uint8_t NO_DIRECTION = 255; //The direction of cells that have nowhere to go
+
+//--- Utility ---//
+//The type used for the open lists. The distance first so the heap is sorted by it, then the cell index
+typedef std::pair<float, int> OpenEntry;
+
+//Returns true if the cell is inside the grid and walkable
+static inline bool isCellWalkable(const uint8_t* grid, int width, int height, int x, int y)
+{
+	return x >= 0 && y >= 0 && x < width && y < height && grid[y * width + x] != 0;
+}
+
+//Returns true if an agent can step from the cell in the given direction. Diagonal steps need both of the cells beside them to be open so corners are never cut
+static inline bool canStep(const uint8_t* grid, int width, int height, int x, int y, int dx, int dy)
+{
+	if (!isCellWalkable(grid, width, height, x + dx, y + dy))
+		return false;
+
+	return dx == 0 || dy == 0 || (isCellWalkable(grid, width, height, x + dx, y) && isCellWalkable(grid, width, height, x, y + dy));
+}
+
+//Adds a cell to a min heap
+static inline void pushOpen(std::vector<OpenEntry>& open, float distance, int cell)
+{
+	open.push_back(OpenEntry(distance, cell));
+	std::push_heap(open.begin(), open.end(), std::greater<OpenEntry>());
+}
+
+//Removes and returns the cell with the smallest distance from a min heap
+static inline OpenEntry popOpen(std::vector<OpenEntry>& open)
+{
+	std::pop_heap(open.begin(), open.end(), std::greater<OpenEntry>());
+	OpenEntry entry = open.back();
+	open.pop_back();
+	return entry;
+}
+
+//Returns the milliseconds since the start time
+static inline double getMillisecondsSince(const std::chrono::steady_clock::time_point& startTime)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+//Clears every counter
+static inline void resetStats(PathStats& stats)
+{
+	stats.milliseconds = 0.0;
+	stats.nodesExpanded = 0;
+	stats.cellsScanned = 0;
+	stats.cellsUpdated = 0;
+	stats.isIncremental = false;
+}
+
+
+
+//--- Jump Point Search ---//
+/*
+	Everything the jump function needs to know about the search
+*/
+struct JumpContext
+{
+	const uint8_t* grid; //The walkable cells
+	int width, height; //The size of the grid
+	int goalX, goalY; //The cell being searched for
+	unsigned int* cellsScanned; //Counts every cell the jumps pass over
+};
+
+/*
+	The search data for a single query. One of these is kept per thread so the worker threads never share them
+	- The generation counters mean the arrays never have to be cleared. A cell's data only counts if its generation matches the current query
+*/
+struct SearchScratch
+{
+	std::vector<float> cost; //The cost of the best known path to each cell
+	std::vector<int> parent; //The jump point each cell was reached from
+	std::vector<unsigned int> openedGeneration; //The query that last reached each cell
+	std::vector<unsigned int> closedGeneration; //The query that last finished each cell
+	std::vector<OpenEntry> open; //The open list
+	unsigned int generation; //The current query
+};
+
+//Walk from a cell in one direction until something interesting is found. Returns true and the jump point if one was found
+static bool jump(const JumpContext& context, int x, int y, int dx, int dy, int& jumpX, int& jumpY)
+{
+	while (true)
+	{
+		x += dx;
+		y += dy;
+
+		if (!isCellWalkable(context.grid, context.width, context.height, x, y))
+			return false;
+
+		(*context.cellsScanned)++;
+
+		//Found the goal
+		if (x == context.goalX && y == context.goalY)
+		{
+			jumpX = x;
+			jumpY = y;
+			return true;
+		}
+
+		if (dx != 0 && dy != 0)
+		{
+			//Moving diagonally. Stop here if either of the straight directions finds something
+			int ignoreX, ignoreY;
+
+			if (jump(context, x, y, dx, 0, ignoreX, ignoreY) || jump(context, x, y, 0, dy, ignoreX, ignoreY))
+			{
+				jumpX = x;
+				jumpY = y;
+				return true;
+			}
+		}
+		else if (dx != 0)
+		{
+			//Moving horizontally. Stop if a wall behind us just ended above or below, since that opens up a new way to go
+			if ((isCellWalkable(context.grid, context.width, context.height, x, y - 1) && !isCellWalkable(context.grid, context.width, context.height, x - dx, y - 1)) ||
+				(isCellWalkable(context.grid, context.width, context.height, x, y + 1) && !isCellWalkable(context.grid, context.width, context.height, x - dx, y + 1)))
+			{
+				jumpX = x;
+				jumpY = y;
+				return true;
+			}
+		}
+		else
+		{
+			//Moving vertically. Same as above, but for walls to the left and right
+			if ((isCellWalkable(context.grid, context.width, context.height, x - 1, y) && !isCellWalkable(context.grid, context.width, context.height, x - 1, y - dy)) ||
+				(isCellWalkable(context.grid, context.width, context.height, x + 1, y) && !isCellWalkable(context.grid, context.width, context.height, x + 1, y - dy)))
+			{
+				jumpX = x;
+				jumpY = y;
+				return true;
+			}
+		}
+
+		//Diagonal moves can't squeeze past a corner, so stop if either side is blocked
+		if (!isCellWalkable(context.grid, context.width, context.height, x + dx, y) || !isCellWalkable(context.grid, context.width, context.height, x, y + dy))
+			return false;
+	}
+}
+
+//Fills in the directions worth searching from a cell, based on the direction it was reached from. Returns how many there are
+static int getPrunedDirections(const uint8_t* grid, int width, int height, int x, int y, int parentX, int parentY, int* directionsX, int* directionsY)
+{
+	int count = 0;
+
+	//The start has no parent, so every direction is worth searching
+	if (parentX < 0)
+	{
+		for (int i = 0; i < 8; i++)
+		{
+			if (canStep(grid, width, height, x, y, NEIGHBOUR_X[i], NEIGHBOUR_Y[i]))
+			{
+				directionsX[count] = NEIGHBOUR_X[i];
+				directionsY[count] = NEIGHBOUR_Y[i];
+				count++;
+			}
+		}
+
+		return count;
+	}
+
+	int dx = (x > parentX) - (x < parentX);
+	int dy = (y > parentY) - (y < parentY);
+
+	//Adds a direction to the list
+	auto add = [&](int addX, int addY)
+	{
+		directionsX[count] = addX;
+		directionsY[count] = addY;
+		count++;
+	};
+
+	if (dx != 0 && dy != 0)
+	{
+		//Diagonal. Keep going straight along either axis, or diagonally if both are open
+		bool isVerticalOpen = isCellWalkable(grid, width, height, x, y + dy);
+		bool isHorizontalOpen = isCellWalkable(grid, width, height, x + dx, y);
+
+		if (isVerticalOpen)
+			add(0, dy);
+		if (isHorizontalOpen)
+			add(dx, 0);
+		if (isVerticalOpen && isHorizontalOpen && isCellWalkable(grid, width, height, x + dx, y + dy))
+			add(dx, dy);
+	}
+	else if (dx != 0)
+	{
+		//Horizontal. Keep going, and turn up or down if it's open
+		bool isNextOpen = isCellWalkable(grid, width, height, x + dx, y);
+		bool isUpOpen = isCellWalkable(grid, width, height, x, y + 1);
+		bool isDownOpen = isCellWalkable(grid, width, height, x, y - 1);
+
+		if (isNextOpen)
+		{
+			add(dx, 0);
+
+			if (isUpOpen && isCellWalkable(grid, width, height, x + dx, y + 1))
+				add(dx, 1);
+			if (isDownOpen && isCellWalkable(grid, width, height, x + dx, y - 1))
+				add(dx, -1);
+		}
+
+		if (isUpOpen)
+			add(0, 1);
+		if (isDownOpen)
+			add(0, -1);
+	}
+	else
+	{
+		//Vertical. Keep going, and turn left or right if it's open
+		bool isNextOpen = isCellWalkable(grid, width, height, x, y + dy);
+		bool isRightOpen = isCellWalkable(grid, width, height, x + 1, y);
+		bool isLeftOpen = isCellWalkable(grid, width, height, x - 1, y);
+
+		if (isNextOpen)
+		{
+			add(0, dy);
+
+			if (isRightOpen && isCellWalkable(grid, width, height, x + 1, y + dy))
+				add(1, dy);
+			if (isLeftOpen && isCellWalkable(grid, width, height, x - 1, y + dy))
+				add(-1, dy);
+		}
+
+		if (isRightOpen)
+			add(1, 0);
+		if (isLeftOpen)
+			add(-1, 0);
+	}
+
+	return count;
+}
+
+//The shortest possible path length between two cells if nothing was in the way
+static inline float getOctileDistance(int x0, int y0, int x1, int y1)
+{
+	int dx = std::abs(x1 - x0);
+	int dy = std::abs(y1 - y0);
+	return (float)(dx + dy) + (DIAGONAL_COST - 2.0f) * (float)std::min(dx, dy);
+}
+
+
+
+//--- Flow Field ---//
+FlowField::FlowField(int _width, int _height, int _goalX, int _goalY)
+{
+	width = _width;
+	height = _height;
+	goalX = _goalX;
+	goalY = _goalY;
+	lastUsed = 0;
+	resetStats(stats);
+}
+
+GridCell FlowField::getGoal() const
+{
+	GridCell goal = { goalX, goalY };
+	return goal;
+}
+
+bool FlowField::getDirection(int cellX, int cellY, int& directionX, int& directionY) const
+{
+	if (cellX < 0 || cellY < 0 || cellX >= width || cellY >= height)
+		return false;
+
+	uint8_t cellDirection = direction[cellY * width + cellX];
+
+	if (cellDirection == NO_DIRECTION)
+		return false;
+
+	directionX = NEIGHBOUR_X[cellDirection];
+	directionY = NEIGHBOUR_Y[cellDirection];
+	return true;
+}
+
+float FlowField::getDistance(int cellX, int cellY) const
+{
+	if (cellX < 0 || cellY < 0 || cellX >= width || cellY >= height)
+		return -1.0f;
+
+	float cellDistance = distance[cellY * width + cellX];
+	return (cellDistance == UNREACHABLE) ? -1.0f : cellDistance;
+}
+
+const PathStats& FlowField::getStats() const
+{
+	return stats;
+}
+
+void FlowField::build(const uint8_t* grid)
+{
+	auto startTime = std::chrono::steady_clock::now();
+	resetStats(stats);
+
+	distance.assign((size_t)width * height, UNREACHABLE);
+	direction.assign((size_t)width * height, NO_DIRECTION);
+
+	std::vector<OpenEntry> open;
+	std::vector<int> changedCells;
+
+	//Spread out from the goal. If the goal is blocked, nothing can reach it
+	int goal = goalY * width + goalX;
+
+	if (grid[goal])
+	{
+		distance[goal] = 0.0f;
+		changedCells.push_back(goal);
+		pushOpen(open, 0.0f, goal);
+	}
+
+	propagate(grid, open, changedCells);
+
+	//Point every cell at its best neighbour
+	for (int cell = 0; cell < width * height; cell++)
+		updateDirection(grid, cell);
+
+	stats.cellsUpdated = (unsigned int)changedCells.size();
+	stats.milliseconds = getMillisecondsSince(startTime);
+}
+
+void FlowField::updateCell(const uint8_t* grid, int cellX, int cellY)
+{
+	auto startTime = std::chrono::steady_clock::now();
+	resetStats(stats);
+	stats.isIncremental = true;
+
+	int changedCell = cellY * width + cellX;
+	std::vector<OpenEntry> open;
+	std::vector<int> changedCells;
+
+	if (grid[changedCell])
+	{
+		//The cell was opened up, so paths can only get shorter. Spread out from every neighbour with a distance and only keep the improvements
+		if (changedCell == goalY * width + goalX)
+		{
+			distance[changedCell] = 0.0f;
+			changedCells.push_back(changedCell);
+			pushOpen(open, 0.0f, changedCell);
+		}
+
+		for (int i = 0; i < 8; i++)
+		{
+			int x = cellX + NEIGHBOUR_X[i];
+			int y = cellY + NEIGHBOUR_Y[i];
+
+			if (x >= 0 && y >= 0 && x < width && y < height && distance[y * width + x] != UNREACHABLE)
+				pushOpen(open, distance[y * width + x], y * width + x);
+		}
+	}
+	else
+	{
+		//The cell was blocked, so paths can only get longer. Only the cells whose path went through it (or squeezed past its corner) are affected
+		//Start with the cell itself and any neighbour whose step is no longer allowed
+		std::vector<int> resetQueue;
+
+		if (distance[changedCell] != UNREACHABLE)
+			resetQueue.push_back(changedCell);
+
+		for (int i = 0; i < 8; i++)
+		{
+			int x = cellX + NEIGHBOUR_X[i];
+			int y = cellY + NEIGHBOUR_Y[i];
+
+			if (x < 0 || y < 0 || x >= width || y >= height)
+				continue;
+
+			uint8_t neighbourDirection = direction[y * width + x];
+
+			if (neighbourDirection != NO_DIRECTION && !canStep(grid, width, height, x, y, NEIGHBOUR_X[neighbourDirection], NEIGHBOUR_Y[neighbourDirection]))
+				resetQueue.push_back(y * width + x);
+		}
+
+		for (unsigned int i = 0; i < resetQueue.size(); i++)
+		{
+			distance[resetQueue[i]] = UNREACHABLE;
+			changedCells.push_back(resetQueue[i]);
+		}
+
+		//Then everything downstream of them. A cell is downstream if its direction points at a reset cell
+		for (unsigned int i = 0; i < resetQueue.size(); i++)
+		{
+			int cell = resetQueue[i];
+			int x = cell % width;
+			int y = cell / width;
+
+			for (int j = 0; j < 8; j++)
+			{
+				int neighbourX = x + NEIGHBOUR_X[j];
+				int neighbourY = y + NEIGHBOUR_Y[j];
+
+				if (neighbourX < 0 || neighbourY < 0 || neighbourX >= width || neighbourY >= height)
+					continue;
+
+				int neighbour = neighbourY * width + neighbourX;
+				uint8_t neighbourDirection = direction[neighbour];
+
+				if (distance[neighbour] != UNREACHABLE && neighbourDirection != NO_DIRECTION && neighbourX + NEIGHBOUR_X[neighbourDirection] == x && neighbourY + NEIGHBOUR_Y[neighbourDirection] == y)
+				{
+					distance[neighbour] = UNREACHABLE;
+					changedCells.push_back(neighbour);
+					resetQueue.push_back(neighbour);
+				}
+			}
+
+			stats.cellsScanned += 8;
+		}
+
+		//Refill the reset cells from the untouched cells around them
+		for (unsigned int i = 0; i < resetQueue.size(); i++)
+		{
+			int x = resetQueue[i] % width;
+			int y = resetQueue[i] / width;
+
+			for (int j = 0; j < 8; j++)
+			{
+				int neighbourX = x + NEIGHBOUR_X[j];
+				int neighbourY = y + NEIGHBOUR_Y[j];
+
+				if (neighbourX >= 0 && neighbourY >= 0 && neighbourX < width && neighbourY < height && distance[neighbourY * width + neighbourX] != UNREACHABLE)
+					pushOpen(open, distance[neighbourY * width + neighbourX], neighbourY * width + neighbourX);
+			}
+		}
+	}
+
+	propagate(grid, open, changedCells);
+
+	//Only the cells that changed, and the ones beside them, can have a new best neighbour
+	changedCells.push_back(changedCell);
+
+	for (unsigned int i = 0; i < changedCells.size(); i++)
+	{
+		int x = changedCells[i] % width;
+		int y = changedCells[i] / width;
+		updateDirection(grid, changedCells[i]);
+
+		for (int j = 0; j < 8; j++)
+		{
+			int neighbourX = x + NEIGHBOUR_X[j];
+			int neighbourY = y + NEIGHBOUR_Y[j];
+
+			if (neighbourX >= 0 && neighbourY >= 0 && neighbourX < width && neighbourY < height)
+				updateDirection(grid, neighbourY * width + neighbourX);
+		}
+	}
+
+	stats.cellsUpdated = (unsigned int)changedCells.size() - 1;
+	stats.milliseconds = getMillisecondsSince(startTime);
+}
+
+void FlowField::propagate(const uint8_t* grid, std::vector<OpenEntry>& open, std::vector<int>& changedCells)
+{
+	//Dijkstra's algorithm. Always spread from the closest cell so every cell's distance is final the first time it is expanded
+	while (!open.empty())
+	{
+		OpenEntry entry = popOpen(open);
+		int cell = entry.second;
+
+		//A shorter distance was found after this entry was added, so this one is out of date
+		if (entry.first > distance[cell])
+			continue;
+
+		stats.nodesExpanded++;
+
+		int x = cell % width;
+		int y = cell / width;
+
+		for (int i = 0; i < 8; i++)
+		{
+			stats.cellsScanned++;
+
+			if (!canStep(grid, width, height, x, y, NEIGHBOUR_X[i], NEIGHBOUR_Y[i]))
+				continue;
+
+			int neighbour = (y + NEIGHBOUR_Y[i]) * width + (x + NEIGHBOUR_X[i]);
+			float neighbourDistance = entry.first + ((i < 4) ? 1.0f : DIAGONAL_COST);
+
+			if (neighbourDistance < distance[neighbour])
+			{
+				distance[neighbour] = neighbourDistance;
+				changedCells.push_back(neighbour);
+				pushOpen(open, neighbourDistance, neighbour);
+			}
+		}
+	}
+}
+
+void FlowField::updateDirection(const uint8_t* grid, int cell)
+{
+	direction[cell] = NO_DIRECTION;
+
+	//The goal, blocked cells and cells that can't reach the goal have nowhere to go
+	if (!grid[cell] || distance[cell] == UNREACHABLE || cell == goalY * width + goalX)
+		return;
+
+	int x = cell % width;
+	int y = cell / width;
+	float bestDistance = UNREACHABLE;
+
+	//Pick the step that leads to the shortest total distance. Straight steps are checked first so they win ties
+	for (int i = 0; i < 8; i++)
+	{
+		if (!canStep(grid, width, height, x, y, NEIGHBOUR_X[i], NEIGHBOUR_Y[i]))
+			continue;
+
+		float stepDistance = distance[(y + NEIGHBOUR_Y[i]) * width + (x + NEIGHBOUR_X[i])] + ((i < 4) ? 1.0f : DIAGONAL_COST);
+
+		if (stepDistance < bestDistance)
+		{
+			bestDistance = stepDistance;
+			direction[cell] = (uint8_t)i;
+		}
+	}
+}
+
+
+
+//--- Constructors and Destructor ---//
+Pathfinder::Pathfinder(int _width, int _height, float _cellSize, const Vec2& _origin)
+{
+	width = std::max(_width, 1);
+	height = std::max(_height, 1);
+	cellSize = _cellSize;
+	origin = _origin;
+	grid = std::make_shared<std::vector<uint8_t>>((size_t)width * height, (uint8_t)1);
+	maxFlowFields = 16;
+	useCounter = 0;
+	aliveToken = std::make_shared<bool>(true);
+}
+
+Pathfinder::~Pathfinder()
+{
+	//Deleting the alive token tells any queries still on the worker thread not to touch this Pathfinder
+	aliveToken.reset();
+}
+
+
+
+//--- Setters ---//
+void Pathfinder::setWalkable(int cellX, int cellY, bool _isWalkable)
+{
+	if (cellX < 0 || cellY < 0 || cellX >= width || cellY >= height)
+		return;
+
+	int cell = cellY * width + cellX;
+	uint8_t value = _isWalkable ? 1 : 0;
+
+	if ((*grid)[cell] == value)
+		return;
+
+	//A worker thread is still searching the grid, so give it the old copy and make a new one to change
+	if (grid.use_count() > 1)
+		grid = std::make_shared<std::vector<uint8_t>>(*grid);
+
+	(*grid)[cell] = value;
+
+	//Patch every cached field
+	for (auto& it : flowFields)
+		it.second->updateCell(grid->data(), cellX, cellY);
+}
+
+void Pathfinder::setMaxFlowFields(unsigned int _maxFlowFields)
+{
+	maxFlowFields = std::max(_maxFlowFields, 1u);
+}
+
+
+
+//--- Getters ---//
+bool Pathfinder::isWalkable(int cellX, int cellY) const
+{
+	return isCellWalkable(grid->data(), width, height, cellX, cellY);
+}
+
+int Pathfinder::getWidth() const
+{
+	return width;
+}
+
+int Pathfinder::getHeight() const
+{
+	return height;
+}
+
+GridCell Pathfinder::worldToCell(const Vec2& position) const
+{
+	GridCell cell = { (int)floorf((position.x - origin.x) / cellSize), (int)floorf((position.y - origin.y) / cellSize) };
+	return cell;
+}
+
+Vec2 Pathfinder::cellToWorld(int cellX, int cellY) const
+{
+	return origin + Vec2((cellX + 0.5f) * cellSize, (cellY + 0.5f) * cellSize);
+}
+
+
+
+//--- Methods ---//
+PathResult Pathfinder::findPath(int startX, int startY, int goalX, int goalY) const
+{
+	PathResult result;
+	runJumpPointSearch(grid->data(), width, height, startX, startY, goalX, goalY, result);
+	return result;
+}
+
+void Pathfinder::findPathAsync(int startX, int startY, int goalX, int goalY, const std::function<void(const PathResult& result)>& callback) const
+{
+	//The worker thread keeps its own reference to the grid so it is never changed under it
+	std::shared_ptr<std::vector<uint8_t>> snapshot = grid;
+	std::shared_ptr<PathResult> result = std::make_shared<PathResult>();
+	int gridWidth = width;
+	int gridHeight = height;
+
+	AsyncTaskPool::getInstance()->enqueue(AsyncTaskPool::TaskType::TASK_OTHER, [result, callback](void*)
+	{
+		//Back on the main thread
+		callback(*result);
+	}, nullptr, [snapshot, result, gridWidth, gridHeight, startX, startY, goalX, goalY]()
+	{
+		//On the worker thread
+		runJumpPointSearch(snapshot->data(), gridWidth, gridHeight, startX, startY, goalX, goalY, *result);
+	});
+}
+
+std::shared_ptr<FlowField> Pathfinder::getFlowField(int goalX, int goalY)
+{
+	if (goalX < 0 || goalY < 0 || goalX >= width || goalY >= height)
+		return nullptr;
+
+	//Most of the time the field already exists
+	int goal = goalY * width + goalX;
+	auto it = flowFields.find(goal);
+
+	if (it != flowFields.end())
+	{
+		it->second->lastUsed = ++useCounter;
+		return it->second;
+	}
+
+	//Otherwise build it and keep it for next time
+	std::shared_ptr<FlowField> field(new FlowField(width, height, goalX, goalY));
+	field->build(grid->data());
+	cacheFlowField(goal, field);
+
+	return field;
+}
+
+std::shared_ptr<FlowField> Pathfinder::getFlowFieldToPoint(const Vec2& position)
+{
+	GridCell goal = worldToCell(position);
+	return getFlowField(goal.x, goal.y);
+}
+
+void Pathfinder::getFlowFieldAsync(int goalX, int goalY, const std::function<void(std::shared_ptr<FlowField> field)>& callback)
+{
+	if (goalX < 0 || goalY < 0 || goalX >= width || goalY >= height)
+	{
+		callback(nullptr);
+		return;
+	}
+
+	//No need for the worker thread if the field already exists
+	int goal = goalY * width + goalX;
+	auto it = flowFields.find(goal);
+
+	if (it != flowFields.end())
+	{
+		it->second->lastUsed = ++useCounter;
+		callback(it->second);
+		return;
+	}
+
+	std::shared_ptr<std::vector<uint8_t>> snapshot = grid;
+	std::shared_ptr<FlowField> field(new FlowField(width, height, goalX, goalY));
+	std::weak_ptr<bool> alive = aliveToken;
+
+	AsyncTaskPool::getInstance()->enqueue(AsyncTaskPool::TaskType::TASK_OTHER, [this, alive, snapshot, field, goal, callback](void*)
+	{
+		//Back on the main thread. If the Pathfinder was deleted in the meantime, just hand the field over
+		if (alive.expired())
+		{
+			callback(field);
+			return;
+		}
+
+		//Another request for the same goal may have finished first
+		auto existing = flowFields.find(goal);
+
+		if (existing != flowFields.end())
+		{
+			existing->second->lastUsed = ++useCounter;
+			callback(existing->second);
+			return;
+		}
+
+		//Patch in any cells that changed while the field was being built, one at a time so each update sees the grid it expects
+		if (grid != snapshot)
+		{
+			PathStats buildStats = field->stats;
+			std::vector<uint8_t> patchedGrid = *snapshot;
+
+			for (int cell = 0; cell < width * height; cell++)
+			{
+				if (patchedGrid[cell] != (*grid)[cell])
+				{
+					patchedGrid[cell] = (*grid)[cell];
+					field->updateCell(patchedGrid.data(), cell % width, cell / width);
+				}
+			}
+
+			field->stats = buildStats;
+		}
+
+		cacheFlowField(goal, field);
+		callback(field);
+	}, nullptr, [snapshot, field]()
+	{
+		//On the worker thread
+		field->build(snapshot->data());
+	});
+}
+
+Vec2 Pathfinder::getFlowDirection(const FlowField& field, const Vec2& position) const
+{
+	GridCell cell = worldToCell(position);
+	int directionX, directionY;
+
+	if (!field.getDirection(cell.x, cell.y, directionX, directionY))
+		return Vec2::ZERO;
+
+	return Vec2((float)directionX, (float)directionY).getNormalized();
+}
+
+
+
+//--- Utility Functions ---//
+void Pathfinder::cacheFlowField(int goalIndex, const std::shared_ptr<FlowField>& field)
+{
+	field->lastUsed = ++useCounter;
+	flowFields[goalIndex] = field;
+
+	//Drop the least recently used fields until there is room. Anything still holding onto one can keep using it, it just won't be updated anymore
+	while (flowFields.size() > maxFlowFields)
+	{
+		auto oldest = flowFields.begin();
+
+		for (auto it = flowFields.begin(); it != flowFields.end(); it++)
+		{
+			if (it->second->lastUsed < oldest->second->lastUsed)
+				oldest = it;
+		}
+
+		flowFields.erase(oldest);
+	}
+}
+
+void Pathfinder::runJumpPointSearch(const uint8_t* grid, int width, int height, int startX, int startY, int goalX, int goalY, PathResult& result)
+{
+	auto startTime = std::chrono::steady_clock::now();
+	resetStats(result.stats);
+	result.isFound = false;
+	result.path.clear();
+	result.cost = 0.0f;
+
+	if (!isCellWalkable(grid, width, height, startX, startY) || !isCellWalkable(grid, width, height, goalX, goalY))
+	{
+		result.stats.milliseconds = getMillisecondsSince(startTime);
+		return;
+	}
+
+	//Get this thread's search data, growing it if the grid is bigger than last time
+	static thread_local SearchScratch scratch;
+	size_t cellCount = (size_t)width * height;
+
+	if (scratch.cost.size() < cellCount)
+	{
+		scratch.cost.resize(cellCount);
+		scratch.parent.resize(cellCount);
+		scratch.openedGeneration.assign(cellCount, 0);
+		scratch.closedGeneration.assign(cellCount, 0);
+		scratch.generation = 0;
+	}
+
+	//Start a new generation. If the counter wraps around, the old generations have to be cleared out
+	if (++scratch.generation == 0)
+	{
+		std::fill(scratch.openedGeneration.begin(), scratch.openedGeneration.end(), 0);
+		std::fill(scratch.closedGeneration.begin(), scratch.closedGeneration.end(), 0);
+		scratch.generation = 1;
+	}
+
+	unsigned int generation = scratch.generation;
+	scratch.open.clear();
+
+	JumpContext context = { grid, width, height, goalX, goalY, &result.stats.cellsScanned };
+	int start = startY * width + startX;
+	int goal = goalY * width + goalX;
+
+	scratch.cost[start] = 0.0f;
+	scratch.parent[start] = -1;
+	scratch.openedGeneration[start] = generation;
+	pushOpen(scratch.open, getOctileDistance(startX, startY, goalX, goalY), start);
+
+	int directionsX[8], directionsY[8];
+
+	while (!scratch.open.empty())
+	{
+		int cell = popOpen(scratch.open).second;
+
+		//Cells can be on the open list more than once. Only the first one counts
+		if (scratch.closedGeneration[cell] == generation)
+			continue;
+
+		scratch.closedGeneration[cell] = generation;
+		result.stats.nodesExpanded++;
+
+		if (cell == goal)
+		{
+			result.isFound = true;
+			break;
+		}
+
+		int x = cell % width;
+		int y = cell / width;
+		int parent = scratch.parent[cell];
+		int directionCount = getPrunedDirections(grid, width, height, x, y, (parent < 0) ? -1 : parent % width, (parent < 0) ? -1 : parent / width, directionsX, directionsY);
+
+		//Jump in each direction and add whatever jump points are found
+		for (int i = 0; i < directionCount; i++)
+		{
+			int jumpX, jumpY;
+
+			if (!jump(context, x, y, directionsX[i], directionsY[i], jumpX, jumpY))
+				continue;
+
+			int jumpCell = jumpY * width + jumpX;
+
+			if (scratch.closedGeneration[jumpCell] == generation)
+				continue;
+
+			float jumpCost = scratch.cost[cell] + getOctileDistance(x, y, jumpX, jumpY);
+
+			if (scratch.openedGeneration[jumpCell] != generation || jumpCost < scratch.cost[jumpCell])
+			{
+				scratch.cost[jumpCell] = jumpCost;
+				scratch.parent[jumpCell] = cell;
+				scratch.openedGeneration[jumpCell] = generation;
+				pushOpen(scratch.open, jumpCost + getOctileDistance(jumpX, jumpY, goalX, goalY), jumpCell);
+			}
+		}
+	}
+
+	if (result.isFound)
+	{
+		//Walk back through the jump points
+		std::vector<int> jumpPoints;
+
+		for (int cell = goal; cell != -1; cell = scratch.parent[cell])
+			jumpPoints.push_back(cell);
+
+		std::reverse(jumpPoints.begin(), jumpPoints.end());
+
+		//Fill in every cell between the jump points. Each jump is either perfectly straight or perfectly diagonal
+		int x = startX;
+		int y = startY;
+		result.path.push_back({ x, y });
+
+		for (unsigned int i = 1; i < jumpPoints.size(); i++)
+		{
+			int targetX = jumpPoints[i] % width;
+			int targetY = jumpPoints[i] / width;
+
+			while (x != targetX || y != targetY)
+			{
+				x += (targetX > x) - (targetX < x);
+				y += (targetY > y) - (targetY < y);
+				result.path.push_back({ x, y });
+			}
+		}
+
+		result.cost = scratch.cost[goal];
+	}
+
+	result.stats.milliseconds = getMillisecondsSince(startTime);
+}
@@ -0,0 +1,280 @@
+/*
+============================================================
+	Pathfinder:
+		- Finds paths on a uniform grid of walkable / blocked cells. Agents can move in 8 directions but never cut the corner of a blocked cell
+		- Two ways to find a path:
+			> findPath() finds a single path with jump point search. It is A* that skips over the long straight runs of open cells, so it looks at far fewer cells than regular A*
+				- Use it for one agent going somewhere the others aren't
+			> getFlowField() builds a map of which way to go from EVERY cell to reach a goal. Any number of agents heading to the same goal share the one field and just look up the direction of the cell they are standing on
+				- Use it for crowds chasing the same target. Ex: every enemy heading for the cursor
+				- Fields are cached per goal. Asking for the same goal again is just a lookup
+				- When setWalkable() changes a cell, every cached field only recalculates the cells whose distance actually changed
+		- Both can run on a worker thread with findPathAsync() and getFlowFieldAsync(). The callback is run back on the main thread
+		- Every query fills in a PathStats so you can see how long it took and how much work it did
+		- Positions can be given in cells or in world space. Ex: getFlowFieldToPoint(INPUTS->getMousePosition())
+
+	Usage:
+		- You are free to use this class for the case studies and for GDW
+		- You are free to edit / overwrite any or all of this class
+			> It is simply here to make your life easier
+		- You must leave this comment block at the top of the header
+
+	Note:
+		- The worker thread never touches the grid you are editing. It works on a copy that is only made if you change a cell while a query is running
+============================================================
+*/
+
+#ifndef PATHFINDER_H
+#define PATHFINDER_H
+
+//Core Libraries
+#include <vector>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+
+//3rd Party Libraries
+#include "cocos2d.h"
+
+//Namespaces
+using namespace cocos2d;
+
+/*
+	Grid Cell Struct
+	- The column and row of a single cell. (0, 0) is the bottom left
+*/
+struct GridCell
+{
+	int x, y; //The column and row
+};
+
+/*
+	Path Stats Struct
+	- Performance counters for a single query
+*/
+struct PathStats
+{
+	double milliseconds; //How long the query took
+	unsigned int nodesExpanded; //How many cells were taken off of the open list (jump points for findPath(), every reached cell for flow fields)
+	unsigned int cellsScanned; //How many cells were looked at in total, including the ones jumped over
+	unsigned int cellsUpdated; //How many cells had their distance changed. For flow fields, this shows how much an incremental update saved over a full rebuild
+	bool isIncremental; //True if this was an incremental flow field update rather than a full build
+};
+
+/*
+	Path Result Struct
+	- The result of findPath()
+*/
+struct PathResult
+{
+	bool isFound; //True if a path was found
+	std::vector<GridCell> path; //Every cell along the path, starting with the start and ending with the goal. Empty if there is no path
+	float cost; //The length of the path in cells. Diagonal steps count as 1.414
+	PathStats stats; //How much work the query did
+};
+
+
+
+/*
+	Flow Field Class:
+	- Every cell's distance to the goal and which way to step to get closer
+	- Created by Pathfinder::getFlowField(). Shared by everything heading to the same goal
+	> Getters
+		- Get the goal
+		- Get the direction / distance from a cell
+		- Get the stats from the last build or update
+*/
+class FlowField
+{
+	friend class Pathfinder;
+
+public:
+	//--- Getters ---//
+	/*
+		@return Returns -> The cell everything is heading to
+	*/
+	GridCell getGoal() const;
+
+	/*
+		Get the direction to step in from a cell
+
+		@param CellX, CellY -> The cell to step from
+		@param DirectionX, DirectionY -> Filled in with the step. Each is -1, 0 or 1
+		@return Returns -> False if the cell is the goal, blocked or can't reach the goal
+	*/
+	bool getDirection(int cellX, int cellY, int& directionX, int& directionY) const;
+
+	/*
+		@return Returns -> The path length from the cell to the goal, or -1 if the goal can't be reached from it
+	*/
+	float getDistance(int cellX, int cellY) const;
+
+	/*
+		@return Returns -> The performance counters from the last full build or incremental update
+	*/
+	const PathStats& getStats() const;
+
+private:
+	//--- Constructor ---//
+	FlowField(int width, int height, int goalX, int goalY); //Only the Pathfinder creates flow fields
+
+	//--- Private Data ---//
+	int width, height; //The size of the grid the field covers
+	int goalX, goalY; //The goal cell
+	std::vector<float> distance; //Every cell's path length to the goal. Infinity if it can't be reached
+	std::vector<uint8_t> direction; //Every cell's direction to step in, as an index into the 8 neighbours. NO_DIRECTION if there isn't one
+	PathStats stats; //The counters from the last build or update
+	unsigned int lastUsed; //When the field was last asked for. The least recently used field is dropped when the cache is full
+
+	//--- Utility Functions ---//
+	void build(const uint8_t* grid); //Calculates every cell from scratch
+	void updateCell(const uint8_t* grid, int cellX, int cellY); //Recalculates only the cells affected by a single cell changing
+	void propagate(const uint8_t* grid, std::vector<std::pair<float, int>>& open, std::vector<int>& changedCells); //Spreads the distances out from the cells on the open list
+	void updateDirection(const uint8_t* grid, int cell); //Picks the neighbour with the shortest distance to the goal
+};
+
+
+
+/*
+	Pathfinder Class:
+	> Setters
+		- Set whether a cell is walkable
+		- Set how many flow fields are cached
+	> Getters
+		- Get whether a cell is walkable
+		- Get the grid size
+		- Convert between world positions and cells
+	> Methods
+		- Find a path (now or on a worker thread)
+		- Get a flow field (now or on a worker thread)
+		- Get the direction to move in from a flow field
+*/
+class Pathfinder
+{
+public:
+	//--- Constructors and Destructor ---//
+	/*
+		Create a grid where every cell is walkable
+
+		@param Width -> The number of columns
+		@param Height -> The number of rows
+		@param CellSize -> The width and height of a cell in world space. Defaulted to 32 pixels
+		@param Origin -> Where the bottom left corner of cell (0, 0) is in world space. Defaulted to (0, 0)
+	*/
+	Pathfinder(int width, int height, float cellSize = 32.0f, const Vec2& origin = Vec2::ZERO);
+	~Pathfinder();
+
+
+
+	//--- Setters ---//
+	/*
+		Block or unblock a cell. Every cached flow field is updated right away, only where it needs to be
+
+		@param CellX, CellY -> The cell to change
+		@param IsWalkable -> True if agents can walk through the cell
+	*/
+	void setWalkable(int cellX, int cellY, bool isWalkable);
+
+	/*
+		@param MaxFlowFields -> The most flow fields kept in the cache. The least recently used one is dropped when there are more. Defaulted to 16
+	*/
+	void setMaxFlowFields(unsigned int maxFlowFields);
+
+
+
+	//--- Getters ---//
+	/*
+		@return Returns -> True if the cell is inside the grid and walkable
+	*/
+	bool isWalkable(int cellX, int cellY) const;
+
+	/*
+		@return Returns -> The number of columns
+	*/
+	int getWidth() const;
+
+	/*
+		@return Returns -> The number of rows
+	*/
+	int getHeight() const;
+
+	/*
+		@param Position -> A position in world space. Ex: INPUTS->getMousePosition()
+		@return Returns -> The cell the position is in. May be outside the grid
+	*/
+	GridCell worldToCell(const Vec2& position) const;
+
+	/*
+		@return Returns -> The center of the cell in world space
+	*/
+	Vec2 cellToWorld(int cellX, int cellY) const;
+
+
+
+	//--- Methods ---//
+	/*
+		Find the shortest path between two cells using jump point search
+
+		@param StartX, StartY -> The cell to start from
+		@param GoalX, GoalY -> The cell to go to
+		@return Returns -> The path and its stats. isFound is false if there is no path
+	*/
+	PathResult findPath(int startX, int startY, int goalX, int goalY) const;
+
+	/*
+		Same as findPath(), but run on a worker thread. Changing cells while the query is running is safe, but the path is found on the grid as it was when this was called
+
+		@param Callback -> Run on the main thread with the result once the path is found
+	*/
+	void findPathAsync(int startX, int startY, int goalX, int goalY, const std::function<void(const PathResult& result)>& callback) const;
+
+	/*
+		Get the flow field leading to a cell, building it if it isn't cached. Call this every time you need it rather than keeping it around, since dropped fields are no longer updated
+
+		@param GoalX, GoalY -> The cell everything is heading to
+		@return Returns -> The flow field
+	*/
+	std::shared_ptr<FlowField> getFlowField(int goalX, int goalY);
+
+	/*
+		Same as getFlowField(), but with the goal in world space
+
+		@param Position -> The goal in world space. Ex: INPUTS->getMousePosition()
+		@return Returns -> The flow field, or nullptr if the position is outside the grid
+	*/
+	std::shared_ptr<FlowField> getFlowFieldToPoint(const Vec2& position);
+
+	/*
+		Same as getFlowField(), but a field that isn't cached is built on a worker thread. Any cells changed while it was being built are patched in before it is handed over
+
+		@param Callback -> Run on the main thread with the field. Run right away if the field is already cached
+	*/
+	void getFlowFieldAsync(int goalX, int goalY, const std::function<void(std::shared_ptr<FlowField> field)>& callback);
+
+	/*
+		Get which way an agent should move to follow a flow field
+
+		@param Field -> The flow field to follow
+		@param Position -> Where the agent is in world space
+		@return Returns -> A direction with a length of 1, or (0, 0) if the agent is at the goal or can't reach it
+	*/
+	Vec2 getFlowDirection(const FlowField& field, const Vec2& position) const;
+
+private:
+	//--- Private Data ---//
+	int width, height; //The size of the grid
+	float cellSize; //The size of a cell in world space
+	Vec2 origin; //The bottom left corner of the grid in world space
+	std::shared_ptr<std::vector<uint8_t>> grid; //1 for walkable cells, 0 for blocked. Shared with the worker thread, so it is copied before being changed if a query is using it
+
+	std::unordered_map<int, std::shared_ptr<FlowField>> flowFields; //The cached flow fields, keyed by the goal cell's index
+	unsigned int maxFlowFields; //The most flow fields kept in the cache
+	unsigned int useCounter; //Counts up every time a field is asked for. Used to find the least recently used field
+	std::shared_ptr<bool> aliveToken; //Lets callbacks from the worker thread know if the Pathfinder was deleted while they were running
+
+	//--- Utility Functions ---//
+	void cacheFlowField(int goalIndex, const std::shared_ptr<FlowField>& field); //Adds a field to the cache, dropping the least recently used one if it is full
+	static void runJumpPointSearch(const uint8_t* grid, int width, int height, int startX, int startY, int goalX, int goalY, PathResult& result); //The actual search. Static so it can run on the worker thread without touching the Pathfinder
+};
+
+#endif
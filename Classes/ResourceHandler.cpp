@@ -0,0 +1,345 @@
+#include "ResourceHandler.h"
+#include "DisplayHandler.h"
+#include "SimpleAudioEngine.h"
+
+//Core Libraries
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+
+//--- Static Variables ---//
+ResourceHandler* ResourceHandler::inst = nullptr;
+
+//--- Constants ---//
+static const unsigned int SOUND_IN_USE_FRAMES = 300; //Sounds played within this many frames might still be playing so they are never unloaded
+static const std::string OVERLAY_UPDATE_KEY = "ResourceHandler_Overlay"; //The scheduler key used by the debug overlay
+
+
+
+//--- Constructor and Destructor ---//
+ResourceHandler::ResourceHandler()
+{
+	//Init the private data. There is no budget until one is set
+	memoryBudget = 0;
+	totalBytes = 0;
+	activeScene = "Default";
+	audioUsed = false;
+}
+
+ResourceHandler::~ResourceHandler()
+{
+	//Delete the singleton instance
+	if (inst)
+		delete inst;
+
+	//Clean up the pointer
+	inst = nullptr;
+}
+
+
+
+//--- Setters ---//
+void ResourceHandler::setMemoryBudget(size_t budgetInBytes)
+{
+	//Set the new budget and immediately unload anything over it
+	memoryBudget = budgetInBytes;
+	enforceBudget();
+}
+
+void ResourceHandler::setActiveScene(const std::string& sceneName)
+{
+	//Every asset loaded from now on will be charged to this scene
+	activeScene = sceneName;
+}
+
+
+
+//--- Getters ---//
+size_t ResourceHandler::getMemoryBudget() const
+{
+	return memoryBudget;
+}
+
+size_t ResourceHandler::getTotalMemoryUsage() const
+{
+	return totalBytes;
+}
+
+size_t ResourceHandler::getSceneMemoryUsage(const std::string& sceneName) const
+{
+	//Add up all of the assets that were loaded while this scene was active
+	size_t sceneBytes = 0;
+
+	for (auto& it : resources)
+	{
+		if (it.second.sceneName == sceneName)
+			sceneBytes += it.second.bytes;
+	}
+
+	return sceneBytes;
+}
+
+size_t ResourceHandler::getTypeMemoryUsage(ResourceType type) const
+{
+	//Add up all of the assets of the requested type
+	size_t typeBytes = 0;
+
+	for (auto& it : resources)
+	{
+		if (it.second.type == type)
+			typeBytes += it.second.bytes;
+	}
+
+	return typeBytes;
+}
+
+std::vector<ResourceInfo> ResourceHandler::getTopConsumers(unsigned int count) const
+{
+	//Copy all of the assets into a list so they can be sorted
+	std::vector<ResourceInfo> consumers;
+	consumers.reserve(resources.size());
+
+	for (auto& it : resources)
+		consumers.push_back(it.second);
+
+	//Only the biggest few need to be in order so a partial sort is enough
+	count = std::min(count, (unsigned int)consumers.size());
+	std::partial_sort(consumers.begin(), consumers.begin() + count, consumers.end(), [](const ResourceInfo& a, const ResourceInfo& b)
+	{
+		return a.bytes > b.bytes;
+	});
+
+	//Cut off everything past the requested number
+	consumers.resize(count);
+	return consumers;
+}
+
+
+
+//--- Methods ---//
+Texture2D* ResourceHandler::loadTexture(const std::string& filePath)
+{
+	//Load the texture through the regular texture cache. If it is already loaded, this simply returns the existing one
+	Texture2D* texture = Director::getInstance()->getTextureCache()->addImage(filePath);
+
+	//If the texture failed to load, there is nothing to track
+	if (!texture)
+		return nullptr;
+
+	//The size on the GPU is the number of pixels times the size of each pixel
+	size_t bytes = (size_t)texture->getPixelsWide() * texture->getPixelsHigh() * texture->getBitsPerPixelForFormat() / 8;
+	track(filePath, ResourceType::Texture, bytes);
+
+	return texture;
+}
+
+const std::string& ResourceHandler::loadFont(const std::string& filePath)
+{
+	//Fonts are loaded by the labels themselves so the file size is all we can count
+	track(filePath, ResourceType::Font, (size_t)FileUtils::getInstance()->getFileSize(filePath));
+
+	return filePath;
+}
+
+void ResourceHandler::preloadSoundEffect(const std::string& filePath)
+{
+	//Load the sound through the regular audio engine then count it
+	audioUsed = true;
+	CocosDenshion::SimpleAudioEngine::getInstance()->preloadEffect(filePath.c_str());
+	track(filePath, ResourceType::Sound, (size_t)FileUtils::getInstance()->getFileSize(filePath));
+}
+
+unsigned int ResourceHandler::playSoundEffect(const std::string& filePath, bool loop)
+{
+	//The audio engine loads the sound automatically if it isn't already, so just count it and play it
+	audioUsed = true;
+	track(filePath, ResourceType::Sound, (size_t)FileUtils::getInstance()->getFileSize(filePath));
+
+	return CocosDenshion::SimpleAudioEngine::getInstance()->playEffect(filePath.c_str(), loop);
+}
+
+void ResourceHandler::playBackgroundMusic(const std::string& filePath, bool loop)
+{
+	//Music is streamed so there is nothing to count. Just remember that the audio engine is now running
+	audioUsed = true;
+	CocosDenshion::SimpleAudioEngine::getInstance()->playBackgroundMusic(filePath.c_str(), loop);
+}
+
+bool ResourceHandler::hasUsedAudio() const
+{
+	return audioUsed;
+}
+
+size_t ResourceHandler::enforceBudget()
+{
+	//A budget of 0 means there is no budget so nothing needs to be unloaded
+	if (memoryBudget == 0)
+		return 0;
+
+	return trimToBudget(memoryBudget);
+}
+
+size_t ResourceHandler::trimToBudget(size_t budgetInBytes)
+{
+	//Make sure the totals are correct before deciding what to unload
+	forgetRemovedTextures();
+
+	//If everything already fits, there is nothing to do
+	if (totalBytes <= budgetInBytes)
+		return 0;
+
+	//Gather all of the assets that can be unloaded. Anything requested this frame is skipped since the caller hasn't had a chance to use it yet
+	unsigned int currentFrame = Director::getInstance()->getTotalFrames();
+	std::vector<ResourceInfo> candidates;
+
+	for (auto& it : resources)
+	{
+		if (it.second.lastUsedFrame != currentFrame && !isInUse(it.second))
+			candidates.push_back(it.second);
+	}
+
+	//Sort them so the least recently used assets are unloaded first
+	std::sort(candidates.begin(), candidates.end(), [](const ResourceInfo& a, const ResourceInfo& b)
+	{
+		return a.lastUsedFrame < b.lastUsedFrame;
+	});
+
+	//Unload assets until the total fits inside the budget
+	size_t bytesFreed = 0;
+
+	for (unsigned int i = 0; i < candidates.size() && totalBytes > budgetInBytes; i++)
+	{
+		unload(candidates[i]);
+
+		totalBytes -= candidates[i].bytes;
+		bytesFreed += candidates[i].bytes;
+		resources.erase(candidates[i].filePath);
+	}
+
+	return bytesFreed;
+}
+
+Node* ResourceHandler::createDebugOverlay(unsigned int count)
+{
+	//Use a system font so the overlay doesn't show up in its own list
+	Label* overlay = Label::createWithSystemFont("", "Arial", 10.0f);
+	overlay->setAnchorPoint(Vec2(0.0f, 1.0f));
+	overlay->setPosition(Vec2(4.0f, DISPLAY->getWindowSize().height - 4.0f));
+	overlay->setTextColor(Color4B::YELLOW);
+
+	//Rebuild the text twice a second. Every frame would be a waste since the numbers rarely change
+	overlay->schedule([this, overlay, count](float deltaTime)
+	{
+		forgetRemovedTextures();
+
+		std::stringstream text;
+		text << std::fixed << std::setprecision(2);
+		text << "Assets: " << totalBytes / (1024.0f * 1024.0f) << " MB";
+
+		if (memoryBudget > 0)
+			text << " / " << memoryBudget / (1024.0f * 1024.0f) << " MB";
+
+		//List the biggest assets along with their type and the scene that loaded them
+		static const char* typeNames[] = { "Texture", "Font", "Sound" };
+
+		for (const ResourceInfo& resource : getTopConsumers(count))
+			text << "\n" << resource.bytes / 1024.0f << " KB  " << typeNames[(int)resource.type] << "  " << resource.filePath << " (" << resource.sceneName << ")";
+
+		overlay->setString(text.str());
+	}, 0.5f, OVERLAY_UPDATE_KEY);
+
+	return overlay;
+}
+
+
+
+//--- Singleton Instance ---//
+ResourceHandler* ResourceHandler::getInstance()
+{
+	//Create the singleton instance if it hasn't already been created
+	if (!inst)
+		inst = new ResourceHandler();
+
+	//Return the singleton instance
+	return inst;
+}
+
+
+
+//--- Utility Functions ---//
+void ResourceHandler::track(const std::string& filePath, ResourceType type, size_t bytes)
+{
+	unsigned int currentFrame = Director::getInstance()->getTotalFrames();
+	auto it = resources.find(filePath);
+
+	//If the asset is already tracked, it is just being used again so update when it was last used
+	if (it != resources.end())
+	{
+		it->second.lastUsedFrame = currentFrame;
+		return;
+	}
+
+	//Otherwise, start tracking it and charge it to the active scene
+	ResourceInfo resource;
+	resource.filePath = filePath;
+	resource.type = type;
+	resource.bytes = bytes;
+	resource.sceneName = activeScene;
+	resource.lastUsedFrame = currentFrame;
+
+	resources[filePath] = resource;
+	totalBytes += bytes;
+
+	//Make room for the new asset if it pushed the total over the budget
+	if (memoryBudget > 0 && totalBytes > memoryBudget)
+		enforceBudget();
+}
+
+bool ResourceHandler::isInUse(const ResourceInfo& resource) const
+{
+	switch (resource.type)
+	{
+	case ResourceType::Texture:
+	{
+		//The texture cache holds one reference. Anything more means a sprite or something else is still using it
+		Texture2D* texture = Director::getInstance()->getTextureCache()->getTextureForKey(resource.filePath);
+		return (texture && texture->getReferenceCount() > 1);
+	}
+
+	case ResourceType::Sound:
+		//The audio engine can't tell us if a sound is still playing so anything played recently is treated as in use
+		return (Director::getInstance()->getTotalFrames() - resource.lastUsedFrame < SOUND_IN_USE_FRAMES);
+
+	default:
+		//Fonts are owned by the labels that use them and can't be unloaded from here
+		return true;
+	}
+}
+
+void ResourceHandler::unload(const ResourceInfo& resource)
+{
+	//Remove the asset from whichever cache it lives in
+	if (resource.type == ResourceType::Texture)
+		Director::getInstance()->getTextureCache()->removeTextureForKey(resource.filePath);
+	else if (resource.type == ResourceType::Sound)
+		CocosDenshion::SimpleAudioEngine::getInstance()->unloadEffect(resource.filePath.c_str());
+}
+
+void ResourceHandler::forgetRemovedTextures()
+{
+	//Other code (like TextureCache::removeUnusedTextures()) can remove textures without telling us. Stop counting those so the totals stay correct
+	TextureCache* textureCache = Director::getInstance()->getTextureCache();
+
+	for (auto it = resources.begin(); it != resources.end();)
+	{
+		if (it->second.type == ResourceType::Texture && !textureCache->getTextureForKey(it->first))
+		{
+			totalBytes -= it->second.bytes;
+			it = resources.erase(it);
+		}
+		else
+		{
+			it++;
+		}
+	}
+}
@@ -0,0 +1,253 @@
+/*
+============================================================
+	Resource Handler:
+		- Keeps track of how much memory the textures, fonts and sounds loaded through it are using
+		- Load your assets through this class instead of calling the Cocos2D caches directly so they are counted
+			> loadTexture() replaces Director::getInstance()->getTextureCache()->addImage()
+			> loadFont() returns the path to pass to Label::createWithTTF()
+			> preloadSoundEffect(), playSoundEffect() and playBackgroundMusic() replace the SimpleAudioEngine versions
+			> The audio engine is only started the first time one of these is called
+		- Call setMemoryBudget() once at startup. When the budget is exceeded, the least recently used assets that NOTHING is using anymore are unloaded
+			> Assets that are still being used (ex: a texture on a sprite in the scene) are never unloaded
+			> Unloaded assets are simply loaded again from disk the next time they are requested
+		- Call setActiveScene() when switching scenes so the memory can be broken down per scene
+		- Call createDebugOverlay() and add the result to a scene to see the biggest consumers on screen
+
+	Usage:
+		- You are free to use this class for the case studies and for GDW
+		- You are free to edit / overwrite any or all of this class
+			> It is simply here to make your life easier
+		- You must leave this comment block at the top of the header
+
+	Note:
+		- This class uses the Singleton design pattern
+			> Do not ever make more than one instance of this class in its current form
+			> You don't ever have to call the constructor for this class. Simply start using it and it will build itself
+			> There is a macro "RESOURCES->" that provides a shortcut for getting the singleton instance
+		- Texture sizes are the exact size on the GPU. Font and sound sizes are the size of the file on disk since the decoded size is hidden inside Cocos2D
+============================================================
+*/
+
+#ifndef RESOURCEHANDLER_H
+#define RESOURCEHANDLER_H
+
+//Core Libraries
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+//3rd Party Libraries
+#include "cocos2d.h"
+
+//Namespaces
+using namespace cocos2d;
+
+/*
+	Resource Type Enum
+	- Used to tell what kind of asset a tracked resource is
+
+	> Texture
+		- An image loaded into the texture cache. Unloaded with TextureCache::removeTexture()
+	> Font
+		- A TTF file used by labels. Fonts are owned by the labels that use them so they are counted but never unloaded
+	> Sound
+		- A sound effect loaded into the audio engine. Unloaded with SimpleAudioEngine::unloadEffect()
+*/
+enum class ResourceType
+{
+	Texture,
+	Font,
+	Sound
+};
+
+/*
+	Resource Info Struct
+	- A single tracked asset. Returned by getTopConsumers()
+*/
+struct ResourceInfo
+{
+	std::string filePath; //The path the asset was loaded from. Also used as the key for the asset
+	ResourceType type; //What kind of asset this is
+	size_t bytes; //How much memory the asset is using
+	std::string sceneName; //The scene that was active when the asset was first loaded
+	unsigned int lastUsedFrame; //The last frame the asset was requested on. Used to find the least recently used assets
+};
+
+
+
+/*
+	Resource Handler Class:
+	> Setters
+		- Set the memory budget
+		- Set the active scene
+	> Getters
+		- Get the memory budget
+		- Get the total memory usage, per scene and per type
+		- Get the biggest consumers
+	> Methods
+		- Load textures, fonts and sounds
+		- Enforce the budget / trim to a smaller budget
+		- Create a debug overlay
+*/
+class ResourceHandler
+{
+protected:
+	//--- Constructor ---//
+	ResourceHandler(); //The constructor is protected so only one instance of this class can ever exist. This is called the singleton pattern.
+
+public:
+	//--- Destructor ---//
+	~ResourceHandler();
+
+
+
+	//--- Setters ---//
+	/*
+		Set the maximum number of bytes the tracked assets can use. When a new asset pushes the total over this, the least recently used assets that aren't in use are unloaded
+
+		@param BudgetInBytes -> The memory budget in bytes. 0 means there is no budget and nothing is ever unloaded automatically
+	*/
+	void setMemoryBudget(size_t budgetInBytes);
+
+	/*
+		Set the name of the scene that is currently loading assets. Every asset loaded after this is charged to that scene. Call this right before creating a new scene
+
+		@param SceneName -> The name of the scene. Ex: setActiveScene("MainMenu")
+	*/
+	void setActiveScene(const std::string& sceneName);
+
+
+
+	//--- Getters ---//
+	/*
+		@return Returns -> The memory budget in bytes. 0 means there is no budget
+	*/
+	size_t getMemoryBudget() const;
+
+	/*
+		@return Returns -> The number of bytes all of the tracked assets are using
+	*/
+	size_t getTotalMemoryUsage() const;
+
+	/*
+		@param SceneName -> The scene you want the memory usage of. This is the name passed to setActiveScene()
+		@return Returns -> The number of bytes the assets loaded by that scene are using
+	*/
+	size_t getSceneMemoryUsage(const std::string& sceneName) const;
+
+	/*
+		@param Type -> The type of asset. Ex: getTypeMemoryUsage(ResourceType::Texture)
+		@return Returns -> The number of bytes all of the assets of that type are using
+	*/
+	size_t getTypeMemoryUsage(ResourceType type) const;
+
+	/*
+		Get the assets using the most memory, sorted from biggest to smallest
+
+		@param Count -> The maximum number of assets to return
+		@return Returns -> A list of the biggest assets. Has less than Count entries if fewer assets are loaded
+	*/
+	std::vector<ResourceInfo> getTopConsumers(unsigned int count) const;
+
+
+
+	//--- Methods ---//
+	/*
+		Load a texture and count it towards the budget. If it is already loaded, the cached version is returned. Use this instead of TextureCache::addImage()
+
+		@param FilePath -> The path to the image. Ex: loadTexture("HelloWorld.png")
+		@return Returns -> The texture, or nullptr if it couldn't be loaded. Use Sprite::createWithTexture() to make a sprite from it
+	*/
+	Texture2D* loadTexture(const std::string& filePath);
+
+	/*
+		Count a TTF font towards the budget
+
+		@param FilePath -> The path to the font. Ex: loadFont("fonts/arial.ttf")
+		@return Returns -> The same path so this can be used inline. Ex: Label::createWithTTF("Hi", RESOURCES->loadFont("fonts/arial.ttf"), 24)
+	*/
+	const std::string& loadFont(const std::string& filePath);
+
+	/*
+		Load a sound effect ahead of time and count it towards the budget. Use this instead of SimpleAudioEngine::preloadEffect()
+
+		@param FilePath -> The path to the sound. Ex: preloadSoundEffect("res/jump.wav")
+	*/
+	void preloadSoundEffect(const std::string& filePath);
+
+	/*
+		Play a sound effect and mark it as recently used. Loads it first if it isn't already loaded. Use this instead of SimpleAudioEngine::playEffect()
+
+		@param FilePath -> The path to the sound. Ex: playSoundEffect("res/jump.wav")
+		@param Loop (optional) -> Defaulted to false. If true, the sound repeats forever
+		@return Returns -> The ID of the sound that is playing. Can be passed to SimpleAudioEngine::stopEffect()
+	*/
+	unsigned int playSoundEffect(const std::string& filePath, bool loop = false);
+
+	/*
+		Play a music track. Music is streamed by the audio engine so it isn't counted towards the budget. Use this instead of SimpleAudioEngine::playBackgroundMusic()
+
+		@param FilePath -> The path to the music. Ex: playBackgroundMusic("res/theme.mp3")
+		@param Loop (optional) -> Defaulted to true. If true, the music repeats forever
+	*/
+	void playBackgroundMusic(const std::string& filePath, bool loop = true);
+
+	/*
+		@return Returns -> True if any sound has been loaded through this class. Used to avoid starting the audio engine just to pause it
+	*/
+	bool hasUsedAudio() const;
+
+	/*
+		Unload the least recently used assets that aren't in use until the total fits inside the memory budget. This is called automatically when a new asset is loaded
+
+		@return Returns -> The number of bytes that were unloaded
+	*/
+	size_t enforceBudget();
+
+	/*
+		Same as enforceBudget() but with a different budget. Used to free up extra memory temporarily, like when the game is minimized
+
+		@param BudgetInBytes -> The number of bytes the assets should fit inside
+		@return Returns -> The number of bytes that were unloaded
+	*/
+	size_t trimToBudget(size_t budgetInBytes);
+
+	/*
+		Create a label that lists the total memory usage and the biggest assets. It updates itself twice a second. Add it to your scene with addChild()
+
+		@param Count (optional) -> Defaulted to 8. How many of the biggest assets are listed
+		@return Returns -> The overlay as an autoreleased node
+	*/
+	Node* createDebugOverlay(unsigned int count = 8);
+
+
+
+	//--- Singleton Instance ---//
+	/*
+		Get the instance of the singleton. You shouldn't ever need to call this directly since the macro (RESOURCES->) automatically calls it
+
+		@return Returns -> The singleton instance of this class. This is the ONLY instance of this class so intrefacing HAS to be done through this instance.
+	*/
+	static ResourceHandler* getInstance();
+
+private:
+	//--- Private Data ---//
+	std::unordered_map<std::string, ResourceInfo> resources; //All of the tracked assets, using their file path as the key
+	size_t memoryBudget; //The maximum number of bytes the assets can use. 0 means no budget
+	size_t totalBytes; //Running total of the bytes used by every tracked asset
+	std::string activeScene; //The scene new assets are charged to
+	bool audioUsed; //True once a sound has been loaded. The audio engine is only started when this happens
+
+	//--- Singleton Instance ---//
+	static ResourceHandler* inst; //The singleton instance of this class. Ie: the only instance that can ever exist
+
+	//--- Utility Functions ---//
+	void track(const std::string& filePath, ResourceType type, size_t bytes); //Adds an asset to the tracked list, or marks it as used if it already is
+	bool isInUse(const ResourceInfo& resource) const; //Returns true if something other than the cache is still using the asset
+	void unload(const ResourceInfo& resource); //Removes the asset from its Cocos2D cache
+	void forgetRemovedTextures(); //Stops tracking textures that were removed from the texture cache by something else
+};
+
+#define RESOURCES ResourceHandler::getInstance() //Macro to make using the class easier. Automatically gets the singleton instance for you
+
+#endif
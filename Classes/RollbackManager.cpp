@@ -0,0 +1,282 @@
+#include "RollbackManager.h"
+#include "Logger.h"
+
+//Core Libraries
+#include <cstring>
+#include <chrono>
+
+//--- Static Variables ---//
+RollbackManager* RollbackManager::inst = nullptr;
+
+//--- Constants ---//
+static const char* SCHEDULE_KEY = "RollbackManager"; //The name the tick is scheduled under
+
+
+
+//--- Constructor and Destructor ---//
+RollbackManager::RollbackManager()
+{
+	scene = nullptr;
+	transport = nullptr;
+	fixedDeltaTime = ROLLBACK_FIXED_DELTA;
+	running = false;
+	resimulating = false;
+	stateSize = 0;
+	currentFrame = 0;
+	confirmedFrames = 0;
+	remoteInput = &lastConfirmedInput;
+	memset(&stats, 0, sizeof(RollbackStats));
+}
+
+RollbackManager::~RollbackManager()
+{
+	//Delete the singleton instance
+	if (inst)
+		delete inst;
+
+	//Clean up the pointer
+	inst = nullptr;
+}
+
+
+
+//--- Getters ---//
+const InputSnapshot& RollbackManager::getRemoteInput() const
+{
+	return *remoteInput;
+}
+
+unsigned int RollbackManager::getFrame() const
+{
+	return currentFrame;
+}
+
+bool RollbackManager::isResimulating() const
+{
+	return resimulating;
+}
+
+bool RollbackManager::isRunning() const
+{
+	return running;
+}
+
+const RollbackStats& RollbackManager::getStats() const
+{
+	return stats;
+}
+
+
+
+//--- Methods ---//
+void RollbackManager::registerState(void* data, unsigned int size)
+{
+	//The buffer can't change size once frames are being saved into it
+	if (running)
+	{
+		LOG_ERROR("RollbackManager: registerState() has to be called before start()");
+		return;
+	}
+
+	StateBlock block;
+	block.data = (unsigned char*)data;
+	block.size = size;
+	stateBlocks.push_back(block);
+	stateSize += size;
+}
+
+void RollbackManager::start(Node* _scene, RollbackTransport* _transport, float _fixedDeltaTime)
+{
+	if (running)
+		stop();
+
+	scene = _scene;
+	scene->retain();
+	transport = _transport;
+	fixedDeltaTime = _fixedDeltaTime;
+	running = true;
+	resimulating = false;
+
+	//Allocate every slot up front so saving a frame never allocates
+	stateBuffer.assign(stateSize * ROLLBACK_MAX_FRAMES, 0);
+
+	for (unsigned int i = 0; i < ROLLBACK_MAX_FRAMES; i++)
+		frames[i] = RollbackFrame();
+
+	currentFrame = 0;
+	confirmedFrames = 0;
+	lastConfirmedInput = InputSnapshot();
+	remoteInput = &lastConfirmedInput;
+	memset(&stats, 0, sizeof(RollbackStats));
+
+	//Take over the scene's update() so it can be called again for rolled back frames
+	scene->unscheduleUpdate();
+	Director::getInstance()->getScheduler()->schedule([this](float deltaTime) { tick(deltaTime); }, this, 0.0f, false, SCHEDULE_KEY);
+}
+
+void RollbackManager::stop()
+{
+	if (!running)
+		return;
+
+	Director::getInstance()->getScheduler()->unschedule(SCHEDULE_KEY, this);
+
+	//Give the scene its own update() back
+	scene->scheduleUpdate();
+	scene->release();
+	scene = nullptr;
+
+	delete transport;
+	transport = nullptr;
+
+	stateBlocks.clear();
+	stateSize = 0;
+	stateBuffer.clear();
+	remoteInput = &lastConfirmedInput;
+	running = false;
+}
+
+
+
+//--- Singleton Instance ---//
+RollbackManager* RollbackManager::getInstance()
+{
+	//Generate the singleton if it hasn't been created yet
+	if (!inst)
+		inst = new RollbackManager();
+
+	//Return the singleton
+	return inst;
+}
+
+
+
+//--- Utility Functions ---//
+void RollbackManager::tick(float deltaTime)
+{
+	//Take in every input the other player has sent. They arrive in order, so each one confirms the next frame
+	unsigned int rollbackFrame = currentFrame;
+	unsigned int receivedFrame;
+	InputSnapshot receivedInput;
+
+	transport->update();
+
+	while (transport->receive(receivedFrame, receivedInput))
+	{
+		//Duplicates and anything out of order are ignored
+		if (receivedFrame != confirmedFrames)
+			continue;
+
+		RollbackFrame& slot = frames[receivedFrame % ROLLBACK_MAX_FRAMES];
+
+		//The other player's input frame number can't be guessed, so it is left out of the comparison
+		slot.remoteInput.frameNumber = receivedInput.frameNumber;
+
+		//The frame was already simulated with a guess. If the guess was wrong, everything from here on has to be run again
+		if (receivedFrame < currentFrame && rollbackFrame == currentFrame && memcmp(&slot.remoteInput, &receivedInput, sizeof(InputSnapshot)) != 0)
+			rollbackFrame = receivedFrame;
+
+		slot.remoteInput = receivedInput;
+		lastConfirmedInput = receivedInput;
+		confirmedFrames++;
+	}
+
+	//Wait for the other player if guessing any further would overwrite the oldest frame that might still need to be rolled back to
+	if (currentFrame >= confirmedFrames + ROLLBACK_MAX_FRAMES)
+	{
+		stats.stalledFrames++;
+		return;
+	}
+
+	//Grab this frame's inputs now, before a rollback overwrites the input handler with older ones
+	//They are only put in this frame's slot after the rollback, since the slot can still hold the frame being rolled back to
+	InputSnapshot localInput;
+	INPUTS->saveState(localInput);
+
+	if (rollbackFrame < currentFrame)
+	{
+		rollback(rollbackFrame);
+		INPUTS->loadState(localInput);
+	}
+
+	frames[currentFrame % ROLLBACK_MAX_FRAMES].localInput = localInput;
+
+	//Send this frame's inputs and run it
+	transport->send(currentFrame, localInput);
+
+	if (currentFrame >= confirmedFrames)
+		predictRemoteInput(currentFrame);
+
+	simulateFrame(currentFrame);
+	currentFrame++;
+}
+
+void RollbackManager::rollback(unsigned int frame)
+{
+	auto startTime = std::chrono::steady_clock::now();
+	loadState(frame);
+	auto restoredTime = std::chrono::steady_clock::now();
+
+	//Run every frame since then again, with the right inputs where they are known and new guesses where they aren't
+	resimulating = true;
+
+	for (unsigned int i = frame; i < currentFrame; i++)
+	{
+		if (i >= confirmedFrames)
+			predictRemoteInput(i);
+
+		INPUTS->loadState(frames[i % ROLLBACK_MAX_FRAMES].localInput);
+		simulateFrame(i);
+	}
+
+	resimulating = false;
+
+	stats.restoreMicroseconds = std::chrono::duration<double, std::micro>(restoredTime - startTime).count();
+	stats.resimulateMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - restoredTime).count();
+	stats.rollbackFrames = currentFrame - frame;
+	stats.totalRollbacks++;
+}
+
+void RollbackManager::simulateFrame(unsigned int frame)
+{
+	RollbackFrame& slot = frames[frame % ROLLBACK_MAX_FRAMES];
+	slot.frame = frame;
+
+	//Save the state from the start of the frame so it can be rolled back to
+	auto startTime = std::chrono::steady_clock::now();
+	saveState(frame);
+	stats.saveMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+
+	remoteInput = &slot.remoteInput;
+	scene->update(fixedDeltaTime);
+}
+
+void RollbackManager::saveState(unsigned int frame)
+{
+	unsigned char* destination = stateBuffer.data() + (frame % ROLLBACK_MAX_FRAMES) * stateSize;
+
+	for (unsigned int i = 0; i < stateBlocks.size(); i++)
+	{
+		memcpy(destination, stateBlocks[i].data, stateBlocks[i].size);
+		destination += stateBlocks[i].size;
+	}
+}
+
+void RollbackManager::loadState(unsigned int frame)
+{
+	const unsigned char* source = stateBuffer.data() + (frame % ROLLBACK_MAX_FRAMES) * stateSize;
+
+	for (unsigned int i = 0; i < stateBlocks.size(); i++)
+	{
+		memcpy(stateBlocks[i].data, source, stateBlocks[i].size);
+		source += stateBlocks[i].size;
+	}
+}
+
+void RollbackManager::predictRemoteInput(unsigned int frame)
+{
+	//Guess the other player is still holding whatever they were holding on the last confirmed frame. Presses and releases only last one frame, so they become held and idle
+	InputSnapshot& prediction = frames[frame % ROLLBACK_MAX_FRAMES].remoteInput;
+	prediction = lastConfirmedInput;
+	prediction.clearForNextFrame();
+}
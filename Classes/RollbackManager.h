@@ -0,0 +1,218 @@
+/*
+============================================================
+	Rollback Manager:
+		- Runs a scene as a fixed step simulation that can go back in time, for two player rollback netcode
+			> Every frame, the gameplay state is copied into a ring buffer and this player's inputs are sent to the other player
+			> The other player's inputs arrive a few frames late, so until then they are guessed (whatever they were holding last)
+			> When the real inputs arrive and don't match the guess, the state is restored to that frame and every frame since is run again through the scene's update() with the right inputs. This all happens in one frame, so the player never sees the wrong guess for long
+		- Gameplay state has to be registered so it can be saved and restored
+			> Ex: ROLLBACK->registerState(playerPositions); in your scene's init(). The data is copied with memcpy, so only plain data works (floats, ints, fixed size arrays, structs of those). NO pointers, std::vector, std::string or Nodes
+			> Nodes are visuals. Set their positions from the registered state at the end of update() instead of storing the state in them
+			> Anything that isn't registered (sprites, particles, tweens, sounds) isn't rolled back. Check isResimulating() to skip things like sounds and effects while frames are being run again
+		- Start it with ROLLBACK->start(this, transport) from your scene's init() after the state is registered
+			> It takes over calling the scene's update(), always with the same fixed delta time so the simulation runs the same way every time
+			> Read the local player with INPUTS-> like normal and the remote player with ROLLBACK->getRemoteInput()
+			> Ex: ROLLBACK->start(this, new LoopbackTransport(4)); plays against a copy of yourself that is 4 frames behind
+
+	Usage:
+		- You are free to use this class for the case studies and for GDW
+		- You are free to edit / overwrite any or all of this class
+			> It is simply here to make your life easier
+		- You must leave this comment block at the top of the header
+
+	Note:
+		- This class uses the Singleton design pattern
+			> Do not ever make more than one instance of this class in its current form
+			> You don't ever have to call the constructor for this class. Simply start using it and it will build itself
+			> There is a macro "ROLLBACK->" that provides a shortcut for getting the singleton instance
+		- The simulation has to be deterministic. The same state and inputs have to give the exact same result every time. No random numbers without a registered seed, no real time
+		- If the other player's inputs fall more than ROLLBACK_MAX_FRAMES behind, the simulation waits for them instead of guessing further
+============================================================
+*/
+
+#ifndef ROLLBACKMANAGER_H
+#define ROLLBACKMANAGER_H
+
+//Core Libraries
+#include <vector>
+
+//3rd Party Libraries
+#include "cocos2d.h"
+
+//Our Classes
+#include "InputHandler.h"
+#include "RollbackTransport.h"
+
+//Namespaces
+using namespace cocos2d;
+
+//Useful shorthands
+#define ROLLBACK_MAX_FRAMES 8 //How many frames of snapshots are kept. This is the furthest back a rollback can go
+#define ROLLBACK_FIXED_DELTA (1.0f / 60.0f) //The delta time passed to the scene's update() by default
+
+/*
+	Rollback Stats Struct
+	- How long the rollback work took on the last frame
+*/
+struct RollbackStats
+{
+	double saveMicroseconds; //Time spent copying the state into the ring buffer
+	double restoreMicroseconds; //Time spent copying the state back out for the last rollback
+	double resimulateMilliseconds; //Time spent running frames again for the last rollback, including the scene's update()
+	unsigned int rollbackFrames; //How many frames the last rollback ran again
+	unsigned int totalRollbacks; //How many rollbacks have happened since start()
+	unsigned int stalledFrames; //How many frames were skipped waiting on the other player
+};
+
+
+
+/*
+	Rollback Manager Class:
+	> Getters
+		- Get the remote player's input
+		- Get the current rollback frame
+		- Get if frames are being run again
+		- Get the stats
+	> Methods
+		- Register gameplay state
+		- Start / stop the rollback simulation
+*/
+class RollbackManager
+{
+protected:
+	//--- Constructor ---//
+	RollbackManager(); //The constructor is protected so only one instance of this class can ever exist. This is called the singleton pattern.
+
+public:
+	//--- Destructor ---//
+	~RollbackManager();
+
+
+
+	//--- Getters ---//
+	/*
+		@return Returns -> The other player's inputs for the frame being simulated. These are a guess until the real inputs arrive. Only valid inside the scene's update()
+	*/
+	const InputSnapshot& getRemoteInput() const;
+
+	/*
+		@return Returns -> The frame being simulated. Starts at 0 when start() is called
+	*/
+	unsigned int getFrame() const;
+
+	/*
+		@return Returns -> True while old frames are being run again after a rollback. Use it to skip sounds and effects that were already played the first time
+	*/
+	bool isResimulating() const;
+
+	/*
+		@return Returns -> True between start() and stop()
+	*/
+	bool isRunning() const;
+
+	/*
+		@return Returns -> The timings and counts from the last frame
+	*/
+	const RollbackStats& getStats() const;
+
+
+
+	//--- Methods ---//
+	/*
+		Register a block of gameplay state to be saved every frame and restored on a rollback. Has to be called before start()
+
+		@param Data -> Where the state is. It has to stay at this address until stop() is called
+		@param Size -> The size of the state in bytes
+	*/
+	void registerState(void* data, unsigned int size);
+
+	/*
+		Same as above, but the size is worked out for you. Ex: registerState(player); registerState(bulletArray);
+
+		@param State -> The state to register
+	*/
+	template<typename T>
+	void registerState(T& state)
+	{
+		registerState(&state, (unsigned int)sizeof(T));
+	}
+
+	/*
+		Start running the scene as a rollback simulation. The scene's own scheduled update() is stopped and called from here instead
+
+		@param Scene -> The scene to simulate. Its update() is called once per frame, and again for every frame that is rolled back
+		@param Transport -> Sends and receives the inputs. The rollback manager deletes it in stop(). Ex: new LoopbackTransport(4)
+		@param FixedDeltaTime (optional) -> The delta time passed to update() every frame. Defaulted to 1/60th of a second
+	*/
+	void start(Node* scene, RollbackTransport* transport, float fixedDeltaTime = ROLLBACK_FIXED_DELTA);
+
+	/*
+		Stop the rollback simulation, give the scene back its own update() and forget every registered state
+	*/
+	void stop();
+
+
+
+	//--- Singleton Instance ---//
+	/*
+		Get the instance of the singleton. You shouldn't ever need to call this directly since the macro (ROLLBACK->) automatically calls it
+
+		@return Returns -> The singleton instance of this class. This is the ONLY instance of this class so intrefacing HAS to be done through this instance.
+	*/
+	static RollbackManager* getInstance();
+
+private:
+	/*
+		State Block Struct
+		- A registered piece of gameplay state
+	*/
+	struct StateBlock
+	{
+		unsigned char* data; //Where the state is
+		unsigned int size; //How many bytes it takes up
+	};
+
+	/*
+		Rollback Frame Struct
+		- Everything needed to run a frame again. One per slot in the ring buffer
+	*/
+	struct RollbackFrame
+	{
+		unsigned int frame; //The frame stored in this slot
+		InputSnapshot localInput; //This player's inputs for the frame
+		InputSnapshot remoteInput; //The other player's inputs for the frame. A guess if the frame hasn't been confirmed yet
+	};
+
+	//--- Private Data ---//
+	Node* scene; //The scene being simulated
+	RollbackTransport* transport; //Sends and receives the inputs
+	float fixedDeltaTime; //The delta time passed to the scene's update()
+	bool running; //True between start() and stop()
+	bool resimulating; //True while frames are being run again
+
+	std::vector<StateBlock> stateBlocks; //Every registered piece of state
+	unsigned int stateSize; //The size of every registered state put together
+	std::vector<unsigned char> stateBuffer; //The saved state for every slot in one flat buffer. Slot i starts at i * stateSize
+	RollbackFrame frames[ROLLBACK_MAX_FRAMES]; //The inputs for every slot
+
+	unsigned int currentFrame; //The next frame to simulate
+	unsigned int confirmedFrames; //How many frames have the other player's real inputs. Every frame before this one is confirmed
+	InputSnapshot lastConfirmedInput; //The other player's inputs on the last confirmed frame. Used to guess the frames after it
+	const InputSnapshot* remoteInput; //The other player's inputs for the frame being simulated
+	RollbackStats stats; //The timings and counts
+
+	//--- Singleton Instance ---//
+	static RollbackManager* inst; //The singleton instance of this class. Ie: the only instance that can ever exist
+
+	//--- Utility Functions ---//
+	void tick(float deltaTime); //Called by the scheduler once per frame. Receives inputs, rolls back if needed and simulates the next frame
+	void rollback(unsigned int frame); //Restores the state from a frame and runs every frame since again
+	void simulateFrame(unsigned int frame); //Saves the state for a frame then runs the scene's update() for it
+	void saveState(unsigned int frame); //Copies every registered state into the frame's slot
+	void loadState(unsigned int frame); //Copies every registered state back out of the frame's slot
+	void predictRemoteInput(unsigned int frame); //Guesses the other player's inputs for an unconfirmed frame
+};
+
+#define ROLLBACK RollbackManager::getInstance() //Macro to make using the class easier. Automatically gets the singleton instance for you
+
+#endif
@@ -0,0 +1,37 @@
+#include "RollbackTransport.h"
+
+//--- Constructor ---//
+LoopbackTransport::LoopbackTransport(unsigned int _delayFrames)
+{
+	delayFrames = _delayFrames;
+	frameCount = 0;
+}
+
+
+
+//--- Methods ---//
+void LoopbackTransport::update()
+{
+	frameCount++;
+}
+
+void LoopbackTransport::send(unsigned int frame, const InputSnapshot& input)
+{
+	LoopbackPacket packet;
+	packet.frame = frame;
+	packet.arrivalTime = frameCount + delayFrames; //The input is sent after this frame's inputs were received, so the soonest it can come back is next frame
+	packet.input = input;
+	packets.push_back(packet);
+}
+
+bool LoopbackTransport::receive(unsigned int& frame, InputSnapshot& input)
+{
+	//The packets are in the order they were sent, so only the oldest one needs to be checked
+	if (packets.empty() || packets.front().arrivalTime > frameCount)
+		return false;
+
+	frame = packets.front().frame;
+	input = packets.front().input;
+	packets.pop_front();
+	return true;
+}
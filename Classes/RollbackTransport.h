@@ -0,0 +1,111 @@
+/*
+============================================================
+	Rollback Transport:
+		- Sends this player's inputs to the other player and receives theirs, one InputSnapshot per frame
+			> The rollback manager (see RollbackManager.h) only talks to this interface, so it doesn't care if the inputs go over UDP, a Steam socket or nowhere at all
+			> Inputs have to arrive IN ORDER with none missing. A real network transport should resend lost packets before handing them over
+		- LoopbackTransport is a stand-in for testing without a second computer
+			> Every input sent comes back as the "remote" player's input a set number of frames later, as if a second player copied you over a laggy connection
+			> Ex: ROLLBACK->start(this, new LoopbackTransport(4)); //4 frames of lag
+
+	Usage:
+		- You are free to use this class for the case studies and for GDW
+		- You are free to edit / overwrite any or all of this class
+			> It is simply here to make your life easier
+		- You must leave this comment block at the top of the header
+============================================================
+*/
+
+#ifndef ROLLBACKTRANSPORT_H
+#define ROLLBACKTRANSPORT_H
+
+//Core Libraries
+#include <deque>
+
+//Our Classes
+#include "InputHandler.h"
+
+
+
+/*
+	Rollback Transport Class:
+	> Methods
+		- Send this player's inputs for a frame
+		- Receive the other player's inputs
+*/
+class RollbackTransport
+{
+public:
+	//--- Destructor ---//
+	virtual ~RollbackTransport() {}
+
+
+
+	//--- Methods ---//
+	/*
+		Called once at the start of every frame, before receive(), even when the simulation is waiting on the other player. Use it for anything that has to happen every frame, like reading from a socket
+	*/
+	virtual void update() {}
+
+	/*
+		Send this player's inputs for a frame. Called once per simulated frame, in order
+
+		@param Frame -> The rollback frame the inputs are for
+		@param Input -> The inputs
+	*/
+	virtual void send(unsigned int frame, const InputSnapshot& input) = 0;
+
+	/*
+		Get the next inputs that have arrived from the other player. Called in a loop every frame until it returns false
+
+		@param Frame -> Set to the rollback frame the inputs are for
+		@param Input -> Set to the inputs
+		@return Returns -> True if there were inputs waiting. False if there is nothing left to receive this frame
+	*/
+	virtual bool receive(unsigned int& frame, InputSnapshot& input) = 0;
+};
+
+
+
+/*
+	Loopback Transport Class:
+	> Constructor
+		- Set the delay in frames
+	> Methods
+		- Sends inputs back to itself after the delay
+*/
+class LoopbackTransport : public RollbackTransport
+{
+public:
+	//--- Constructor ---//
+	/*
+		@param DelayFrames -> How many frames each input takes to come back. Ex: 4 frames is about 67ms of lag at 60 fps. Anything under 1 is treated as 1
+	*/
+	LoopbackTransport(unsigned int delayFrames);
+
+
+
+	//--- Methods ---//
+	virtual void update() override;
+	virtual void send(unsigned int frame, const InputSnapshot& input) override;
+	virtual bool receive(unsigned int& frame, InputSnapshot& input) override;
+
+private:
+	/*
+		Loopback Packet Struct
+		- An input on its way back
+	*/
+	struct LoopbackPacket
+	{
+		unsigned int frame; //The frame the input is for
+		unsigned int arrivalTime; //The value of frameCount when it can be received
+		InputSnapshot input; //The input
+	};
+
+	//--- Private Data ---//
+	unsigned int delayFrames; //How long each input takes to come back
+	unsigned int frameCount; //How many times update() has been called. Used as the clock
+	std::deque<LoopbackPacket> packets; //The inputs that haven't come back yet, oldest first
+};
+
+#endif
@@ -0,0 +1,300 @@
+#include "SceneStreamer.h"
+#include "ResourceHandler.h"
+#include "Logger.h"
+
+//Core Libraries
+#include <chrono>
+
+//--- Static Variables ---//
+SceneStreamer* SceneStreamer::inst = nullptr;
+
+//--- Constants ---//
+static const char* SCHEDULE_KEY = "SceneStreamer"; //The name the tick is scheduled under
+
+
+
+//--- Scene Stream ---//
+SceneStream::SceneStream()
+{
+	fadeTime = 0.0f;
+}
+
+
+
+//--- Constructor and Destructor ---//
+SceneStreamer::SceneStreamer()
+{
+	frameBudget = 4.0f;
+	isScheduled = false;
+	stage = SceneStreamStage::Idle;
+	pendingLoads = 0;
+	totalLoads = 0;
+	incomingScene = nullptr;
+	nextStep = 0;
+}
+
+SceneStreamer::~SceneStreamer()
+{
+	//Delete the singleton instance
+	if (inst)
+		delete inst;
+
+	//Clean up the pointer
+	inst = nullptr;
+}
+
+
+
+//--- Setters ---//
+void SceneStreamer::setFrameBudget(float milliseconds)
+{
+	frameBudget = milliseconds;
+}
+
+
+
+//--- Getters ---//
+SceneStreamStage SceneStreamer::getStage() const
+{
+	return stage;
+}
+
+float SceneStreamer::getProgress() const
+{
+	//The background loads and the setup steps are counted the same, one unit each
+	float totalWork = (float)(totalLoads + stream.setupSteps.size());
+
+	switch (stage)
+	{
+	case SceneStreamStage::Idle:
+	case SceneStreamStage::Swapping:
+		return 1.0f;
+
+	case SceneStreamStage::Background:
+		return (totalWork > 0.0f) ? (float)(totalLoads - pendingLoads) / totalWork : 0.0f;
+
+	case SceneStreamStage::Setup:
+		return (totalWork > 0.0f) ? (float)(totalLoads + nextStep) / totalWork : 1.0f;
+	}
+
+	return 0.0f;
+}
+
+bool SceneStreamer::isCleaningUp() const
+{
+	return !outgoingScenes.empty();
+}
+
+
+
+//--- Methods ---//
+bool SceneStreamer::streamScene(const SceneStream& _stream)
+{
+	if (stage != SceneStreamStage::Idle || !_stream.createScene)
+		return false;
+
+	stream = _stream;
+	stage = SceneStreamStage::Background;
+	nextStep = 0;
+	totalLoads = (unsigned int)stream.textures.size() + (stream.loadData ? 1 : 0);
+	pendingLoads = totalLoads;
+
+	//Decode every image on the texture cache's loading thread. The GPU upload happens back on the main thread
+	TextureCache* textureCache = Director::getInstance()->getTextureCache();
+
+	for (unsigned int i = 0; i < stream.textures.size(); i++)
+	{
+		std::string filePath = stream.textures[i];
+
+		textureCache->addImageAsync(filePath, [this, filePath](Texture2D* texture)
+		{
+			//Already in the texture cache, so this just counts it in the resource handler's memory usage
+			if (texture)
+				RESOURCES->loadTexture(filePath);
+
+			onBackgroundLoadFinished();
+		});
+	}
+
+	//Run the user's loading code on a worker thread. The first lambda is run back on the main thread once it is done
+	if (stream.loadData)
+	{
+		std::function<void()> loadData = stream.loadData;
+
+		AsyncTaskPool::getInstance()->enqueue(AsyncTaskPool::TaskType::TASK_IO, [this](void*)
+		{
+			onBackgroundLoadFinished();
+		}, nullptr, [loadData]()
+		{
+			loadData();
+		});
+	}
+
+	schedule();
+
+	//Nothing to wait on, so go straight to the setup
+	if (totalLoads == 0)
+		stage = SceneStreamStage::Setup;
+
+	return true;
+}
+
+
+
+//--- Singleton Instance ---//
+SceneStreamer* SceneStreamer::getInstance()
+{
+	//Generate the singleton if it hasn't been created yet
+	if (!inst)
+		inst = new SceneStreamer();
+
+	//Return the singleton
+	return inst;
+}
+
+
+
+//--- Utility Functions ---//
+void SceneStreamer::tick(float deltaTime)
+{
+	double budgetEnd = getTime() + frameBudget;
+
+	//Build the new scene a few steps at a time
+	if (stage == SceneStreamStage::Setup)
+		runSetupSteps(budgetEnd);
+
+	//The Director switches scenes at the start of the next frame (or at the end of the fade), so wait for the new scene to actually be running
+	if (stage == SceneStreamStage::Swapping && incomingScene->isRunning())
+	{
+		incomingScene->release();
+		incomingScene = nullptr;
+		stage = SceneStreamStage::Idle;
+	}
+
+	//Take apart the old scenes with whatever time is left
+	cleanUpOutgoing(budgetEnd);
+
+	//Stop ticking once there is nothing left to do
+	if (stage == SceneStreamStage::Idle && outgoingScenes.empty())
+	{
+		Director::getInstance()->getScheduler()->unschedule(SCHEDULE_KEY, this);
+		isScheduled = false;
+	}
+}
+
+void SceneStreamer::runSetupSteps(double budgetEnd)
+{
+	//Create the empty scene first. It is retained so it isn't autoreleased while it is being built over several frames
+	if (!incomingScene)
+	{
+		incomingScene = stream.createScene();
+
+		if (!incomingScene)
+		{
+			LOG_ERROR("SceneStreamer: createScene() for \"{}\" returned nullptr", stream.name);
+			stage = SceneStreamStage::Idle;
+			return;
+		}
+
+		incomingScene->retain();
+	}
+
+	//Always run at least one step so the scene finishes even if every step goes over the budget
+	do
+	{
+		if (nextStep >= stream.setupSteps.size())
+			break;
+
+		stream.setupSteps[nextStep](incomingScene);
+		nextStep++;
+	} while (getTime() < budgetEnd);
+
+	if (nextStep >= stream.setupSteps.size())
+		swapScenes();
+}
+
+void SceneStreamer::swapScenes()
+{
+	Director* director = Director::getInstance();
+
+	//Hold on to the old scene so the Director doesn't delete it in one go
+	Scene* outgoingScene = director->getRunningScene();
+
+	if (outgoingScene)
+	{
+		outgoingScene->retain();
+		outgoingScenes.push_back(outgoingScene);
+	}
+
+	if (stream.fadeTime > 0.0f)
+		director->replaceScene(TransitionFade::create(stream.fadeTime, incomingScene));
+	else
+		director->replaceScene(incomingScene);
+
+	if (!stream.name.empty())
+		RESOURCES->setActiveScene(stream.name);
+
+	stage = SceneStreamStage::Swapping;
+
+	if (stream.onSwapped)
+		stream.onSwapped(incomingScene);
+
+	//Let go of the functions now so anything they captured is freed
+	stream.loadData = nullptr;
+	stream.createScene = nullptr;
+	stream.setupSteps.clear();
+	stream.onSwapped = nullptr;
+}
+
+void SceneStreamer::cleanUpOutgoing(double budgetEnd)
+{
+	while (!outgoingScenes.empty())
+	{
+		Scene* scene = outgoingScenes.front();
+
+		//Still on screen (ex: fading out). Wait until the Director is done with it
+		if (scene->isRunning())
+			return;
+
+		//Something else is still holding the scene (ex: it was pushed on the scene stack). It isn't ours to take apart
+		if (scene->getReferenceCount() > 1 || scene->getChildrenCount() == 0)
+		{
+			scene->release();
+			outgoingScenes.erase(outgoingScenes.begin());
+			continue;
+		}
+
+		//Remove the deepest last node. Removing a node deletes everything under it, so going from the bottom up keeps each removal small
+		Node* node = scene;
+
+		while (node->getChildrenCount() > 0)
+			node = node->getChildren().back();
+
+		node->removeFromParentAndCleanup(true);
+
+		if (getTime() >= budgetEnd)
+			return;
+	}
+}
+
+void SceneStreamer::onBackgroundLoadFinished()
+{
+	pendingLoads--;
+
+	if (pendingLoads == 0 && stage == SceneStreamStage::Background)
+		stage = SceneStreamStage::Setup;
+}
+
+void SceneStreamer::schedule()
+{
+	if (isScheduled)
+		return;
+
+	Director::getInstance()->getScheduler()->schedule([this](float deltaTime) { tick(deltaTime); }, this, 0.0f, false, SCHEDULE_KEY);
+	isScheduled = true;
+}
+
+double SceneStreamer::getTime()
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
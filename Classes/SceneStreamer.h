@@ -0,0 +1,181 @@
+/*
+============================================================
+	Scene Streamer:
+		- Loads the next scene while the current one keeps running, then swaps them without a freeze
+			> Creating a big scene in one go (like HelloWorld::createScene() does) stops the game until everything is loaded
+			> Instead, the work is split into stages and spread out over as many frames as it needs
+		- The stages, in order:
+			> Background: the images are decoded on a worker thread with addImageAsync() and your loadData function runs on another worker thread (ex: reading a level file)
+			> Setup: back on the main thread, the scene is created and your setup steps are run a few at a time, only as many as fit in the frame budget
+			> Swap: the scene is handed to the Director with replaceScene()
+			> Cleanup: the old scene is taken apart a few nodes per frame instead of all at once
+		- Ex:
+			> SceneStream stream;
+			> stream.name = "Level1";
+			> stream.textures = { "level1/tiles.png", "level1/enemies.png" };
+			> stream.loadData = [level]() { level->load("level1.txt"); }; //NO Nodes in here, it isn't on the main thread
+			> stream.createScene = []() { return Scene::create(); };
+			> for (int row = 0; row < 100; row++) stream.setupSteps.push_back([level, row](Scene* scene) { level->spawnRow(scene, row); });
+			> SCENES->streamScene(stream);
+
+	Usage:
+		- You are free to use this class for the case studies and for GDW
+		- You are free to edit / overwrite any or all of this class
+			> It is simply here to make your life easier
+		- You must leave this comment block at the top of the header
+
+	Note:
+		- This class uses the Singleton design pattern
+			> Do not ever make more than one instance of this class in its current form
+			> You don't ever have to call the constructor for this class. Simply start using it and it will build itself
+			> There is a macro "SCENES->" that provides a shortcut for getting the singleton instance
+		- Only one scene can be streamed in at a time. The old scene can still be getting cleaned up while the next one loads
+============================================================
+*/
+
+#ifndef SCENESTREAMER_H
+#define SCENESTREAMER_H
+
+//Core Libraries
+#include <string>
+#include <vector>
+#include <functional>
+
+//3rd Party Libraries
+#include "cocos2d.h"
+
+//Namespaces
+using namespace cocos2d;
+
+/*
+	Scene Stream Struct
+	- Everything needed to stream in a scene. Fill in what you need and pass it to streamScene()
+*/
+struct SceneStream
+{
+	std::string name; //Passed to RESOURCES->setActiveScene() when the scene is swapped in
+	std::vector<std::string> textures; //Images to load in the background. They are in the texture cache by the time the setup steps run
+	std::function<void()> loadData; //Optional. Runs on a worker thread. Load files and build plain data here. NEVER create Nodes or touch the scene from it
+	std::function<Scene*()> createScene; //Creates the empty scene on the main thread. Keep it quick, put the slow work in the setup steps
+	std::vector<std::function<void(Scene* scene)>> setupSteps; //Run on the main thread in order, as many per frame as fit in the budget. Each one should be small (ex: spawn one row of enemies)
+	float fadeTime; //If above 0, the scenes fade through black over this many seconds. Defaulted to 0
+	std::function<void(Scene* scene)> onSwapped; //Optional. Run right after the scene is handed to the Director
+
+	SceneStream();
+};
+
+/*
+	Scene Stream Stage Enum
+	- Where the streamer is up to
+*/
+enum class SceneStreamStage
+{
+	Idle, //Nothing is being streamed
+	Background, //Waiting on the worker threads
+	Setup, //Running the setup steps on the main thread
+	Swapping //Waiting for the Director to finish switching scenes
+};
+
+
+
+/*
+	Scene Streamer Class:
+	> Setters
+		- Set the frame budget
+	> Getters
+		- Get the stage and progress
+		- Get if the old scene is still being cleaned up
+	> Methods
+		- Stream in a scene
+*/
+class SceneStreamer
+{
+protected:
+	//--- Constructor ---//
+	SceneStreamer(); //The constructor is protected so only one instance of this class can ever exist. This is called the singleton pattern.
+
+public:
+	//--- Destructor ---//
+	~SceneStreamer();
+
+
+
+	//--- Setters ---//
+	/*
+		Set how much of each frame can be spent on the main thread work (setup steps and cleaning up the old scene). At least one step is always run per frame
+
+		@param Milliseconds -> The budget per frame. Defaulted to 4ms, which leaves plenty of a 16.6ms frame for the running scene
+	*/
+	void setFrameBudget(float milliseconds);
+
+
+
+	//--- Getters ---//
+	/*
+		@return Returns -> What the streamer is doing right now
+	*/
+	SceneStreamStage getStage() const;
+
+	/*
+		@return Returns -> How far along the scene being streamed is, from 0 to 1. Useful for a loading bar
+	*/
+	float getProgress() const;
+
+	/*
+		@return Returns -> True while an old scene is still being taken apart
+	*/
+	bool isCleaningUp() const;
+
+
+
+	//--- Methods ---//
+	/*
+		Start streaming in a scene. The current scene keeps running until the new one is ready
+
+		@param Stream -> The scene to load. See the example at the top of this file
+		@return Returns -> True if it started. False if another scene is already being streamed or there is no createScene function
+	*/
+	bool streamScene(const SceneStream& stream);
+
+
+
+	//--- Singleton Instance ---//
+	/*
+		Get the instance of the singleton. You shouldn't ever need to call this directly since the macro (SCENES->) automatically calls it
+
+		@return Returns -> The singleton instance of this class. This is the ONLY instance of this class so intrefacing HAS to be done through this instance.
+	*/
+	static SceneStreamer* getInstance();
+
+private:
+	//--- Private Data ---//
+	float frameBudget; //Milliseconds per frame for the main thread work
+	bool isScheduled; //True while tick() is being called every frame
+
+	//The scene coming in
+	SceneStreamStage stage; //What is being done
+	SceneStream stream; //The scene being streamed
+	unsigned int pendingLoads; //The background jobs that haven't finished yet (every texture plus loadData)
+	unsigned int totalLoads; //The number of background jobs at the start
+	Scene* incomingScene; //The scene being set up. Retained until the Director has it
+	unsigned int nextStep; //The next setup step to run
+
+	//The scene going out
+	std::vector<Scene*> outgoingScenes; //Old scenes waiting to be taken apart. Retained until they are empty
+
+	//--- Singleton Instance ---//
+	static SceneStreamer* inst; //The singleton instance of this class. Ie: the only instance that can ever exist
+
+	//--- Utility Functions ---//
+	void tick(float deltaTime); //Called by the scheduler every frame while there is work to do
+	void runSetupSteps(double budgetEnd); //Runs setup steps until they are done or the budget runs out
+	void swapScenes(); //Hands the new scene to the Director and queues the old one for cleanup
+	void cleanUpOutgoing(double budgetEnd); //Removes nodes from the old scenes until they are empty or the budget runs out
+	void onBackgroundLoadFinished(); //Called on the main thread every time a texture or loadData finishes
+	void schedule(); //Starts calling tick() every frame
+	static double getTime(); //The current time in milliseconds
+};
+
+#define SCENES SceneStreamer::getInstance() //Macro to make using the class easier. Automatically gets the singleton instance for you
+
+#endif
@@ -0,0 +1,179 @@
+#include "StartupTracer.h"
+#include "Logger.h"
+
+//Core Libraries
+#include <iomanip>
+#include <fstream>
+#include <ctime>
+
+//3rd Party Libraries
+#include "cocos2d.h"
+
+//--- Static Variables ---//
+StartupTracer* StartupTracer::inst = nullptr;
+
+//--- Constants ---//
+static const std::string METRICS_FILE_NAME = "startup_metrics.csv"; //The file in the writable path that the results are added to
+
+
+
+//--- Constructor and Destructor ---//
+StartupTracer::StartupTracer()
+{
+	//Init the private data. Nothing is timed until begin() is called
+	hasBegun = false;
+	inPhase = false;
+	hasFinished = false;
+	timeToFirstFrame = 0.0;
+}
+
+StartupTracer::~StartupTracer()
+{
+	//Delete the singleton instance
+	if (inst)
+		delete inst;
+
+	//Clean up the pointer
+	inst = nullptr;
+}
+
+
+
+//--- Getters ---//
+const std::vector<StartupPhase>& StartupTracer::getPhases() const
+{
+	return phases;
+}
+
+double StartupTracer::getTimeToFirstFrame() const
+{
+	return timeToFirstFrame;
+}
+
+double StartupTracer::getElapsedMs() const
+{
+	//Convert the time since begin() into milliseconds with a fractional part
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+
+
+//--- Methods ---//
+void StartupTracer::begin()
+{
+	//Only the first call starts the clock so calling this twice doesn't lose the early phases
+	if (hasBegun)
+		return;
+
+	startTime = std::chrono::steady_clock::now();
+	hasBegun = true;
+}
+
+void StartupTracer::beginPhase(const std::string& name)
+{
+	//Make sure the clock is running and nothing is recorded after the report is out
+	begin();
+
+	if (hasFinished)
+		return;
+
+	//Phases can't overlap, so close the previous one first
+	if (inPhase)
+		endPhase();
+
+	StartupPhase phase;
+	phase.name = name;
+	phase.startMs = getElapsedMs();
+	phase.durationMs = 0.0;
+
+	phases.push_back(phase);
+	inPhase = true;
+}
+
+void StartupTracer::endPhase()
+{
+	//Ignore the call if there isn't a phase running
+	if (!inPhase)
+		return;
+
+	phases.back().durationMs = getElapsedMs() - phases.back().startMs;
+	inPhase = false;
+}
+
+void StartupTracer::finish()
+{
+	//Only the first call does anything
+	if (hasFinished)
+		return;
+
+	//Close off anything still running and record the total
+	endPhase();
+	timeToFirstFrame = getElapsedMs();
+	hasFinished = true;
+
+	//Output the results
+	printReport();
+	saveMetrics();
+}
+
+bool StartupTracer::isFinished() const
+{
+	return hasFinished;
+}
+
+
+
+//--- Singleton Instance ---//
+StartupTracer* StartupTracer::getInstance()
+{
+	//Create the singleton instance if it hasn't already been created
+	if (!inst)
+		inst = new StartupTracer();
+
+	//Return the singleton instance
+	return inst;
+}
+
+
+
+//--- Utility Functions ---//
+void StartupTracer::printReport() const
+{
+	//Output each phase with when it started and how long it took
+	LOG_INFO("--- Startup Trace ---");
+
+	for (const StartupPhase& phase : phases)
+		LOG_INFO("{:10.2f} ms  {:10.2f} ms  {}", phase.startMs, phase.durationMs, phase.name);
+
+	LOG_INFO("Time to first frame: {:.2f} ms", timeToFirstFrame);
+}
+
+void StartupTracer::saveMetrics() const
+{
+	//Open the metrics file in the writable path. Each run adds one line to the end so the results can be compared over time
+	std::string filePath = cocos2d::FileUtils::getInstance()->getWritablePath() + METRICS_FILE_NAME;
+	bool isNewFile = !cocos2d::FileUtils::getInstance()->isFileExist(filePath);
+	std::ofstream file(filePath, std::ios::app);
+
+	if (!file.is_open())
+		return;
+
+	//Write the column names the first time the file is created
+	if (isNewFile)
+	{
+		file << "timestamp,time_to_first_frame_ms";
+
+		for (const StartupPhase& phase : phases)
+			file << "," << phase.name << "_ms";
+
+		file << "\n";
+	}
+
+	//Write the results for this run
+	file << (long long)std::time(nullptr) << "," << std::fixed << std::setprecision(3) << timeToFirstFrame;
+
+	for (const StartupPhase& phase : phases)
+		file << "," << phase.durationMs;
+
+	file << "\n";
+}
@@ -0,0 +1,143 @@
+/*
+============================================================
+	Startup Tracer:
+		- Times each step of the game starting up so you can see what is making it slow to open
+		- Call begin() as early as possible. AppDelegate does this in its constructor
+		- Wrap each step with beginPhase() and endPhase()
+			> Ex: STARTUP->beginPhase("Load Level"); loadLevel(); STARTUP->endPhase();
+		- Call finish() once the first frame has been shown on screen. AppDelegate does this automatically
+			> This prints a report of every phase and the total time to first frame
+			> The results are also added to "startup_metrics.csv" in the writable path so they can be tracked over time
+
+	Usage:
+		- You are free to use this class for the case studies and for GDW
+		- You are free to edit / overwrite any or all of this class
+			> It is simply here to make your life easier
+		- You must leave this comment block at the top of the header
+
+	Note:
+		- This class uses the Singleton design pattern
+			> Do not ever make more than one instance of this class in its current form
+			> You don't ever have to call the constructor for this class. Simply start using it and it will build itself
+			> There is a macro "STARTUP->" that provides a shortcut for getting the singleton instance
+============================================================
+*/
+
+#ifndef STARTUPTRACER_H
+#define STARTUPTRACER_H
+
+//Core Libraries
+#include <string>
+#include <vector>
+#include <chrono>
+
+/*
+	Startup Phase Struct
+	- A single timed step of the startup
+*/
+struct StartupPhase
+{
+	std::string name; //The name passed to beginPhase()
+	double startMs; //When the phase started, in milliseconds since begin()
+	double durationMs; //How long the phase took in milliseconds
+};
+
+
+
+/*
+	Startup Tracer Class:
+	> Getters
+		- Get the recorded phases
+		- Get the time to first frame
+	> Methods
+		- Begin / finish the trace
+		- Begin / end a phase
+*/
+class StartupTracer
+{
+protected:
+	//--- Constructor ---//
+	StartupTracer(); //The constructor is protected so only one instance of this class can ever exist. This is called the singleton pattern.
+
+public:
+	//--- Destructor ---//
+	~StartupTracer();
+
+
+
+	//--- Getters ---//
+	/*
+		@return Returns -> Every phase that has been recorded, in the order they started
+	*/
+	const std::vector<StartupPhase>& getPhases() const;
+
+	/*
+		@return Returns -> The number of milliseconds between begin() and finish(). This is the time to first frame. Returns 0 if finish() hasn't been called yet
+	*/
+	double getTimeToFirstFrame() const;
+
+	/*
+		@return Returns -> The number of milliseconds since begin() was called
+	*/
+	double getElapsedMs() const;
+
+
+
+	//--- Methods ---//
+	/*
+		Start the trace. Every time is measured from this point. Only the first call does anything
+	*/
+	void begin();
+
+	/*
+		Start timing a phase. Phases can't overlap so this ends the previous phase if it is still going
+
+		@param Name -> The name of the phase shown in the report. Ex: beginPhase("GL View Creation")
+	*/
+	void beginPhase(const std::string& name);
+
+	/*
+		Stop timing the current phase
+	*/
+	void endPhase();
+
+	/*
+		Stop the trace, print the report and save the results. Only the first call does anything so this is safe to call every frame
+	*/
+	void finish();
+
+	/*
+		@return Returns -> True once finish() has been called
+	*/
+	bool isFinished() const;
+
+
+
+	//--- Singleton Instance ---//
+	/*
+		Get the instance of the singleton. You shouldn't ever need to call this directly since the macro (STARTUP->) automatically calls it
+
+		@return Returns -> The singleton instance of this class. This is the ONLY instance of this class so intrefacing HAS to be done through this instance.
+	*/
+	static StartupTracer* getInstance();
+
+private:
+	//--- Private Data ---//
+	std::chrono::steady_clock::time_point startTime; //When begin() was called
+	std::vector<StartupPhase> phases; //Every phase recorded so far
+	bool hasBegun; //True once begin() has been called
+	bool inPhase; //True while a phase is being timed
+	bool hasFinished; //True once finish() has been called
+	double timeToFirstFrame; //The total startup time in milliseconds
+
+	//--- Singleton Instance ---//
+	static StartupTracer* inst; //The singleton instance of this class. Ie: the only instance that can ever exist
+
+	//--- Utility Functions ---//
+	void printReport() const; //Outputs every phase and the total to the console
+	void saveMetrics() const; //Adds a line with the results to startup_metrics.csv
+};
+
+#define STARTUP StartupTracer::getInstance() //Macro to make using the class easier. Automatically gets the singleton instance for you
+
+#endif
@@ -0,0 +1,383 @@
+#include "TileMapNode.h"
+#include "DisplayHandler.h"
+#include "ResourceHandler.h"
+
+//Core Libraries
+#include <cmath>
+#include <cstring>
+
+//--- Utility ---//
+//Division that always rounds down, even for negative numbers. Needed so tile -1 lands in chunk -1 instead of chunk 0
+static int floorDivide(int value, int divisor)
+{
+	return (value >= 0) ? (value / divisor) : ((value - divisor + 1) / divisor);
+}
+
+
+
+//--- Creation ---//
+TileMapNode* TileMapNode::create(const std::string& tilesetPath, float tileSize)
+{
+	//Same pattern as CREATE_FUNC, but with parameters
+	TileMapNode* node = new (std::nothrow) TileMapNode();
+	if (node && node->init(tilesetPath, tileSize))
+	{
+		node->autorelease();
+		return node;
+	}
+
+	CC_SAFE_DELETE(node);
+	return nullptr;
+}
+
+
+
+//--- Constructor and Destructor ---//
+TileMapNode::TileMapNode()
+{
+	tileset = nullptr;
+	blendFunc = BlendFunc::ALPHA_PREMULTIPLIED;
+	tileSize = 0.0f;
+	tilesetColumns = 1;
+	streamingMargin = 1;
+	maxChunkLoadsPerFrame = 4;
+	visibleChunkCount = 0;
+	frameNumber = 0;
+}
+
+TileMapNode::~TileMapNode()
+{
+	//Unload every chunk so the unloader gets a chance to save them
+	for (auto& it : chunks)
+		unloadChunk(it.second);
+
+	chunks.clear();
+
+	//Let go of the tileset
+	CC_SAFE_RELEASE_NULL(tileset);
+}
+
+
+
+//--- Setters ---//
+void TileMapNode::setTile(int tileX, int tileY, TileID tile)
+{
+	//Find the chunk the tile is in, loading it if needed
+	int chunkX = floorDivide(tileX, TILE_CHUNK_SIZE);
+	int chunkY = floorDivide(tileY, TILE_CHUNK_SIZE);
+
+	TileChunk* chunk = findChunk(chunkX, chunkY);
+
+	if (!chunk)
+		chunk = loadChunk(chunkX, chunkY);
+
+	//Change the tile and flag the chunk so its vertices are rebuilt before it is drawn next
+	int localX = tileX - chunkX * TILE_CHUNK_SIZE;
+	int localY = tileY - chunkY * TILE_CHUNK_SIZE;
+	chunk->tiles[localY * TILE_CHUNK_SIZE + localX] = tile;
+	chunk->isDirty = true;
+}
+
+void TileMapNode::setChunkLoader(const std::function<void(int chunkX, int chunkY, TileID* tiles)>& loader)
+{
+	chunkLoader = loader;
+}
+
+void TileMapNode::setChunkUnloader(const std::function<void(int chunkX, int chunkY, const TileID* tiles)>& unloader)
+{
+	chunkUnloader = unloader;
+}
+
+void TileMapNode::setStreamingMargin(int margin)
+{
+	streamingMargin = std::max(margin, 0);
+}
+
+void TileMapNode::setMaxChunkLoadsPerFrame(unsigned int maxLoads)
+{
+	maxChunkLoadsPerFrame = std::max(maxLoads, 1u);
+}
+
+
+
+//--- Getters ---//
+TileID TileMapNode::getTile(int tileX, int tileY) const
+{
+	//If the chunk isn't loaded, there is no way to know what is there so treat it as empty
+	int chunkX = floorDivide(tileX, TILE_CHUNK_SIZE);
+	int chunkY = floorDivide(tileY, TILE_CHUNK_SIZE);
+
+	TileChunk* chunk = findChunk(chunkX, chunkY);
+
+	if (!chunk)
+		return 0;
+
+	int localX = tileX - chunkX * TILE_CHUNK_SIZE;
+	int localY = tileY - chunkY * TILE_CHUNK_SIZE;
+	return chunk->tiles[localY * TILE_CHUNK_SIZE + localX];
+}
+
+float TileMapNode::getTileSize() const
+{
+	return tileSize;
+}
+
+unsigned int TileMapNode::getLoadedChunkCount() const
+{
+	return (unsigned int)chunks.size();
+}
+
+unsigned int TileMapNode::getVisibleChunkCount() const
+{
+	return visibleChunkCount;
+}
+
+
+
+//--- Methods ---//
+void TileMapNode::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
+{
+	frameNumber++;
+	visibleChunkCount = 0;
+
+	//Work out which chunks the camera can see
+	Rect view = getViewBounds();
+	float chunkPixels = tileSize * TILE_CHUNK_SIZE;
+	int minChunkX = (int)floorf(view.getMinX() / chunkPixels);
+	int maxChunkX = (int)floorf(view.getMaxX() / chunkPixels);
+	int minChunkY = (int)floorf(view.getMinY() / chunkPixels);
+	int maxChunkY = (int)floorf(view.getMaxY() / chunkPixels);
+
+	unsigned int loadsLeft = maxChunkLoadsPerFrame;
+
+	//First, load, rebuild and draw the chunks the camera can actually see. These get the load budget first
+	for (int chunkY = minChunkY; chunkY <= maxChunkY; chunkY++)
+	{
+		for (int chunkX = minChunkX; chunkX <= maxChunkX; chunkX++)
+		{
+			TileChunk* chunk = findChunk(chunkX, chunkY);
+
+			//Skip the chunk for now if we've already loaded as many as we're allowed to this frame. It'll be loaded next frame
+			if (!chunk)
+			{
+				if (loadsLeft == 0)
+					continue;
+
+				chunk = loadChunk(chunkX, chunkY);
+				loadsLeft--;
+			}
+
+			chunk->lastVisibleFrame = frameNumber;
+
+			//Only rebuild the vertices if a tile changed
+			if (chunk->isDirty)
+				rebuildChunk(chunk);
+
+			//Don't bother drawing a chunk that is completely empty
+			if (chunk->indices.empty())
+				continue;
+
+			TrianglesCommand::Triangles triangles;
+			triangles.verts = chunk->vertices.data();
+			triangles.vertCount = (int)chunk->vertices.size();
+			triangles.indices = chunk->indices.data();
+			triangles.indexCount = (int)chunk->indices.size();
+
+			chunk->command.init(_globalZOrder, tileset->getName(), getGLProgramState(), blendFunc, triangles, transform, flags);
+			renderer->addCommand(&chunk->command);
+			visibleChunkCount++;
+		}
+	}
+
+	//Next, load the chunks just outside the view with whatever budget is left so they are ready before the camera gets there
+	for (int chunkY = minChunkY - streamingMargin; chunkY <= maxChunkY + streamingMargin; chunkY++)
+	{
+		for (int chunkX = minChunkX - streamingMargin; chunkX <= maxChunkX + streamingMargin; chunkX++)
+		{
+			TileChunk* chunk = findChunk(chunkX, chunkY);
+
+			if (!chunk)
+			{
+				if (loadsLeft == 0)
+					continue;
+
+				chunk = loadChunk(chunkX, chunkY);
+				loadsLeft--;
+			}
+
+			chunk->lastVisibleFrame = frameNumber;
+		}
+	}
+
+	//Finally, unload the chunks the camera has moved away from. The extra 1 chunk gap stops chunks on the edge from loading and unloading every frame
+	int unloadMargin = streamingMargin + 1;
+
+	for (auto it = chunks.begin(); it != chunks.end();)
+	{
+		TileChunk* chunk = it->second;
+		bool isFarAway = chunk->chunkX < minChunkX - unloadMargin || chunk->chunkX > maxChunkX + unloadMargin || chunk->chunkY < minChunkY - unloadMargin || chunk->chunkY > maxChunkY + unloadMargin;
+
+		if (isFarAway)
+		{
+			unloadChunk(chunk);
+			it = chunks.erase(it);
+		}
+		else
+		{
+			it++;
+		}
+	}
+}
+
+bool TileMapNode::init(const std::string& tilesetPath, float _tileSize)
+{
+	//Ensure the parent class was init first
+	if (!Node::init())
+		return false;
+
+	//Load the tileset through the resource handler so it is counted towards the memory budget
+	tileset = RESOURCES->loadTexture(tilesetPath);
+
+	if (!tileset || _tileSize <= 0.0f)
+		return false;
+
+	tileset->retain();
+	blendFunc = tileset->hasPremultipliedAlpha() ? BlendFunc::ALPHA_PREMULTIPLIED : BlendFunc::ALPHA_NON_PREMULTIPLIED;
+
+	//Use nearest neighbour filtering so the edges of neighbouring tiles in the tileset don't bleed into each other
+	tileset->setAliasTexParameters();
+
+	tileSize = _tileSize;
+	tilesetColumns = std::max((int)(tileset->getPixelsWide() / tileSize), 1);
+
+	//Use the same shader as sprites, which takes the vertices already in world space
+	setGLProgramState(GLProgramState::getOrCreateWithGLProgramName(GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR_NO_MVP));
+
+	return true;
+}
+
+
+
+//--- Utility Functions ---//
+long long TileMapNode::getChunkKey(int chunkX, int chunkY)
+{
+	//Put the x in the top 32 bits and the y in the bottom 32 bits
+	//The shift is done on unsigned values since shifting a negative number is undefined, and chunks can have negative positions
+	return (long long)(((unsigned long long)(unsigned int)chunkX << 32) | (unsigned int)chunkY);
+}
+
+TileChunk* TileMapNode::findChunk(int chunkX, int chunkY) const
+{
+	auto it = chunks.find(getChunkKey(chunkX, chunkY));
+	return (it != chunks.end()) ? it->second : nullptr;
+}
+
+TileChunk* TileMapNode::loadChunk(int chunkX, int chunkY)
+{
+	//Create the chunk empty, then let the loader fill it in
+	TileChunk* chunk = new TileChunk();
+	chunk->chunkX = chunkX;
+	chunk->chunkY = chunkY;
+	chunk->isDirty = true;
+	chunk->lastVisibleFrame = frameNumber;
+	memset(chunk->tiles, 0, sizeof(chunk->tiles));
+
+	if (chunkLoader)
+		chunkLoader(chunkX, chunkY, chunk->tiles);
+
+	chunks[getChunkKey(chunkX, chunkY)] = chunk;
+	return chunk;
+}
+
+void TileMapNode::unloadChunk(TileChunk* chunk)
+{
+	//Give the unloader a chance to save the tiles before they are gone
+	if (chunkUnloader)
+		chunkUnloader(chunk->chunkX, chunk->chunkY, chunk->tiles);
+
+	delete chunk;
+}
+
+void TileMapNode::rebuildChunk(TileChunk* chunk)
+{
+	chunk->vertices.clear();
+	chunk->indices.clear();
+
+	//The size of a single tile in texture coordinates
+	float tileU = tileSize / tileset->getPixelsWide();
+	float tileV = tileSize / tileset->getPixelsHigh();
+
+	//Where the chunk starts, in pixels
+	float originX = chunk->chunkX * TILE_CHUNK_SIZE * tileSize;
+	float originY = chunk->chunkY * TILE_CHUNK_SIZE * tileSize;
+
+	for (int y = 0; y < TILE_CHUNK_SIZE; y++)
+	{
+		for (int x = 0; x < TILE_CHUNK_SIZE; x++)
+		{
+			TileID tile = chunk->tiles[y * TILE_CHUNK_SIZE + x];
+
+			//Empty tiles don't get any vertices at all
+			if (tile == 0)
+				continue;
+
+			//Find the tile in the tileset. Tile 1 is the top left
+			int column = (tile - 1) % tilesetColumns;
+			int row = (tile - 1) / tilesetColumns;
+			float left = column * tileU;
+			float right = left + tileU;
+			float top = row * tileV;
+			float bottom = top + tileV;
+
+			//Where the tile goes in the chunk
+			float posLeft = originX + x * tileSize;
+			float posBottom = originY + y * tileSize;
+			float posRight = posLeft + tileSize;
+			float posTop = posBottom + tileSize;
+
+			//Add the four corners. Bottom left, bottom right, top left, top right
+			unsigned short corner = (unsigned short)chunk->vertices.size();
+			chunk->vertices.push_back({ Vec3(posLeft, posBottom, 0.0f), Color4B::WHITE, Tex2F(left, bottom) });
+			chunk->vertices.push_back({ Vec3(posRight, posBottom, 0.0f), Color4B::WHITE, Tex2F(right, bottom) });
+			chunk->vertices.push_back({ Vec3(posLeft, posTop, 0.0f), Color4B::WHITE, Tex2F(left, top) });
+			chunk->vertices.push_back({ Vec3(posRight, posTop, 0.0f), Color4B::WHITE, Tex2F(right, top) });
+
+			//Two triangles per tile
+			unsigned short tileIndices[] = { corner, (unsigned short)(corner + 1), (unsigned short)(corner + 2), (unsigned short)(corner + 3), (unsigned short)(corner + 2), (unsigned short)(corner + 1) };
+			chunk->indices.insert(chunk->indices.end(), tileIndices, tileIndices + 6);
+		}
+	}
+
+	chunk->isDirty = false;
+}
+
+Rect TileMapNode::getViewBounds() const
+{
+	//The camera is centered on the view, which is the size of the window
+	const Camera* camera = Camera::getVisitingCamera();
+	Size windowSize = DISPLAY->getWindowSize();
+	Vec2 cameraPosition = camera ? camera->getPosition() : Vec2(windowSize.width, windowSize.height) / 2.0f;
+
+	//Get the corners of the view in world space, then bring them into the node's space. This takes care of the node being moved, scaled or rotated
+	Mat4 worldToNode = getWorldToNodeTransform();
+	Vec2 corners[4] =
+	{
+		PointApplyTransform(cameraPosition + Vec2(-windowSize.width, -windowSize.height) / 2.0f, worldToNode),
+		PointApplyTransform(cameraPosition + Vec2(windowSize.width, -windowSize.height) / 2.0f, worldToNode),
+		PointApplyTransform(cameraPosition + Vec2(-windowSize.width, windowSize.height) / 2.0f, worldToNode),
+		PointApplyTransform(cameraPosition + Vec2(windowSize.width, windowSize.height) / 2.0f, worldToNode)
+	};
+
+	//Find the box that fits around all four corners
+	float minX = corners[0].x, maxX = corners[0].x, minY = corners[0].y, maxY = corners[0].y;
+
+	for (unsigned int i = 1; i < 4; i++)
+	{
+		minX = std::min(minX, corners[i].x);
+		maxX = std::max(maxX, corners[i].x);
+		minY = std::min(minY, corners[i].y);
+		maxY = std::max(maxY, corners[i].y);
+	}
+
+	return Rect(minX, minY, maxX - minX, maxY - minY);
+}
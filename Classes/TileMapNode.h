@@ -0,0 +1,180 @@
+/*
+============================================================
+	Tile Map Node:
+		- Draws a large grid of tiles without making a Sprite for every tile
+			> The map is split into chunks of 32x32 tiles. Each chunk builds its vertices once and keeps them until one of its tiles changes
+			> Only the chunks that overlap the camera's view are drawn
+			> Chunks are loaded when the camera gets close to them and unloaded once it moves far enough away, so only the area around the camera is ever in memory
+		- The tiles come from a tileset image. Tile 0 is empty, tile 1 is the top left tile of the tileset, tile 2 is the one to the right of it, etc.
+		- Call setChunkLoader() to fill in each chunk's tiles when it is loaded (from a file, a generator, etc.)
+			> Call setChunkUnloader() if you want to save a chunk's tiles before it is thrown away
+		- Add it to a scene like any other node
+			> Ex: TileMapNode* map = TileMapNode::create("res/tiles.png", 16.0f); map->setChunkLoader(...); this->addChild(map);
+
+	Usage:
+		- You are free to use this class for the case studies and for GDW
+		- You are free to edit / overwrite any or all of this class
+			> It is simply here to make your life easier
+		- You must leave this comment block at the top of the header
+============================================================
+*/
+
+#ifndef TILEMAPNODE_H
+#define TILEMAPNODE_H
+
+//Core Libraries
+#include <string>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+
+//3rd Party Libraries
+#include "cocos2d.h"
+
+//Namespaces
+using namespace cocos2d;
+
+//Useful shorthands
+#define TILE_CHUNK_SIZE 32 //The width and height of a chunk, in tiles
+typedef unsigned short TileID; //The type used to store a single tile. 0 is always empty
+
+/*
+	Tile Chunk Struct
+	- A square block of tiles along with the vertices built from them
+*/
+struct TileChunk
+{
+	int chunkX, chunkY; //Which chunk this is. Chunk (0, 0) starts at the node's origin
+	TileID tiles[TILE_CHUNK_SIZE * TILE_CHUNK_SIZE]; //The tiles, row by row starting from the bottom left
+	std::vector<V3F_C4B_T2F> vertices; //The cached vertices for every non-empty tile. Rebuilt only when a tile changes
+	std::vector<unsigned short> indices; //The cached indices to go with the vertices
+	TrianglesCommand command; //The draw command for this chunk
+	bool isDirty; //True if a tile changed since the vertices were built
+	unsigned int lastVisibleFrame; //The last frame the chunk was near the camera. Handy for debugging streaming
+};
+
+
+
+/*
+	Tile Map Node Class:
+	> Setters
+		- Set a tile
+		- Set the chunk loader / unloader
+		- Set how far around the view chunks are kept loaded
+	> Getters
+		- Get a tile
+		- Get the tile size
+		- Get chunk statistics
+	> Methods
+		- Create
+		- Draw (called by Cocos2D)
+*/
+class TileMapNode : public Node
+{
+public:
+	//--- Creation ---//
+	/*
+		Create a tile map. It is an autoreleased object like everything else made with create()
+
+		@param TilesetPath -> The image holding every tile, laid out in a grid. Ex: "res/tiles.png"
+		@param TileSize -> The width and height of a single tile in pixels, both in the tileset and on screen
+		@return Returns -> The new node, or nullptr if the tileset couldn't be loaded
+	*/
+	static TileMapNode* create(const std::string& tilesetPath, float tileSize);
+
+
+
+	//--- Setters ---//
+	/*
+		Change a single tile. If its chunk isn't loaded, it is loaded first. Only that chunk's vertices are rebuilt
+
+		@param TileX -> The column of the tile
+		@param TileY -> The row of the tile, counting up from the bottom
+		@param Tile -> The new tile. 0 for empty
+	*/
+	void setTile(int tileX, int tileY, TileID tile);
+
+	/*
+		Set the function that fills in a chunk's tiles when it is loaded. Without one, new chunks start out empty
+
+		@param Loader -> Called with the chunk's position and an array of TILE_CHUNK_SIZE * TILE_CHUNK_SIZE tiles to fill in, row by row from the bottom left
+	*/
+	void setChunkLoader(const std::function<void(int chunkX, int chunkY, TileID* tiles)>& loader);
+
+	/*
+		Set the function that is called right before a chunk is unloaded. Use it to save any changes made with setTile()
+
+		@param Unloader -> Called with the chunk's position and its tiles
+	*/
+	void setChunkUnloader(const std::function<void(int chunkX, int chunkY, const TileID* tiles)>& unloader);
+
+	/*
+		@param Margin -> How many chunks past the edge of the view are loaded ahead of time. Chunks further than this plus 1 are unloaded. Defaulted to 1
+	*/
+	void setStreamingMargin(int margin);
+
+	/*
+		@param MaxLoads -> The most chunks loaded in a single frame. Visible chunks are loaded first, then the ones in the margin. Keeps fast camera movement from causing a big hitch. Defaulted to 4
+	*/
+	void setMaxChunkLoadsPerFrame(unsigned int maxLoads);
+
+
+
+	//--- Getters ---//
+	/*
+		@return Returns -> The tile at the given position, or 0 if its chunk isn't loaded
+	*/
+	TileID getTile(int tileX, int tileY) const;
+
+	/*
+		@return Returns -> The width and height of a tile in pixels
+	*/
+	float getTileSize() const;
+
+	/*
+		@return Returns -> The number of chunks currently in memory
+	*/
+	unsigned int getLoadedChunkCount() const;
+
+	/*
+		@return Returns -> The number of chunks drawn last frame
+	*/
+	unsigned int getVisibleChunkCount() const;
+
+
+
+	//--- Methods ---//
+	virtual void draw(Renderer* renderer, const Mat4& transform, uint32_t flags) override; //Streams the chunks around the camera in and out and draws the visible ones. Called by Cocos2D every frame
+
+protected:
+	//--- Constructor and Destructor ---//
+	TileMapNode(); //Use create() instead
+	virtual ~TileMapNode();
+
+	bool init(const std::string& tilesetPath, float tileSize); //Loads the tileset. Called by create()
+
+private:
+	//--- Private Data ---//
+	Texture2D* tileset; //The image holding every tile. Retained so the resource handler never unloads it while it is being used
+	BlendFunc blendFunc; //How the tiles are blended. Depends on whether the tileset has premultiplied alpha
+	float tileSize; //The width and height of a tile in pixels
+	int tilesetColumns; //How many tiles fit across the tileset
+	int streamingMargin; //How many chunks past the view are kept loaded
+	unsigned int maxChunkLoadsPerFrame; //The most chunks loaded per frame
+	unsigned int visibleChunkCount; //The number of chunks drawn last frame
+	unsigned int frameNumber; //Counts up every draw. Used to track when each chunk was last seen
+
+	std::unordered_map<long long, TileChunk*> chunks; //Every loaded chunk, keyed by its position
+	std::function<void(int, int, TileID*)> chunkLoader; //Fills in new chunks
+	std::function<void(int, int, const TileID*)> chunkUnloader; //Saves chunks before they are thrown away
+
+	//--- Utility Functions ---//
+	static long long getChunkKey(int chunkX, int chunkY); //Packs a chunk position into a single key for the map
+	TileChunk* findChunk(int chunkX, int chunkY) const; //Returns the chunk if it is loaded, nullptr if not
+	TileChunk* loadChunk(int chunkX, int chunkY); //Creates a chunk and fills it in with the loader
+	void unloadChunk(TileChunk* chunk); //Calls the unloader and deletes the chunk
+	void rebuildChunk(TileChunk* chunk); //Builds the vertices for every non-empty tile in the chunk
+	Rect getViewBounds() const; //The area the camera can see, in the node's local space
+};
+
+#endif
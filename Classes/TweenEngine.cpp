@@ -0,0 +1,474 @@
+#include "TweenEngine.h"
+
+//Core Libraries
+#include <algorithm>
+
+//--- Static Variables ---//
+TweenEngine* TweenEngine::inst = nullptr;
+
+//--- Constants ---//
+static const unsigned int HANDLE_INDEX_BITS = 20; //The bottom 20 bits of an ID are the handle, the top 12 are the generation
+static const unsigned int HANDLE_INDEX_MASK = (1u << HANDLE_INDEX_BITS) - 1; //Gets the handle out of an ID
+static const unsigned int GENERATION_MASK = (1u << (32 - HANDLE_INDEX_BITS)) - 1; //Keeps the generation inside the top 12 bits
+static const float MIN_DURATION = 0.0001f; //Durations are clamped to this so they are never divided by 0
+
+//The cubic for each easing: a*t^3 + b*t^2 + c*t. Every curve goes from 0 at t = 0 to 1 at t = 1
+static const float EASING_CURVES[(int)TweenEasing::NumEasings][3] =
+{
+	{ 0.0f, 0.0f, 1.0f }, //Linear: t
+	{ 0.0f, 1.0f, 0.0f }, //QuadIn: t^2
+	{ 0.0f, -1.0f, 2.0f }, //QuadOut: 1 - (1 - t)^2
+	{ 1.0f, 0.0f, 0.0f }, //CubicIn: t^3
+	{ 1.0f, -3.0f, 3.0f }, //CubicOut: 1 - (1 - t)^3
+	{ -2.0f, 3.0f, 0.0f }, //SmoothStep: 3t^2 - 2t^3
+	{ 2.70158f, -1.70158f, 0.0f }, //BackIn: (s + 1)t^3 - st^2, with the usual overshoot s = 1.70158
+	{ 2.70158f, -6.40316f, 4.70158f } //BackOut: 1 + (s + 1)(t - 1)^3 + s(t - 1)^2, multiplied out
+};
+
+//The number of floats each property has
+static const unsigned int PROPERTY_VALUES[(int)TweenProperty::NumProperties] = { 2, 1, 1, 1, 3 };
+
+
+
+//--- Constructor and Destructor ---//
+TweenEngine::TweenEngine()
+{
+	//Set up each group for its property
+	for (int i = 0; i < (int)TweenProperty::NumProperties; i++)
+	{
+		groups[i].numValues = PROPERTY_VALUES[i];
+		groups[i].numWaiting = 0;
+	}
+}
+
+TweenEngine::~TweenEngine()
+{
+	//Delete the singleton instance
+	if (inst)
+		delete inst;
+
+	//Clean up the pointer
+	inst = nullptr;
+}
+
+
+
+//--- Setters ---//
+void TweenEngine::setOnComplete(TweenID id, const std::function<void()>& callback)
+{
+	if (!isActive(id))
+		return;
+
+	const TweenHandle& handle = handles[id & HANDLE_INDEX_MASK];
+	groups[(int)handle.property].onComplete[handle.index] = callback;
+}
+
+
+
+//--- Getters ---//
+bool TweenEngine::isActive(TweenID id) const
+{
+	//The handle has to exist, be in use, and not have been reused since this ID was handed out
+	unsigned int index = id & HANDLE_INDEX_MASK;
+	return index < handles.size() && handles[index].isActive && handles[index].generation == (id >> HANDLE_INDEX_BITS);
+}
+
+unsigned int TweenEngine::getActiveCount() const
+{
+	unsigned int count = 0;
+
+	for (int i = 0; i < (int)TweenProperty::NumProperties; i++)
+		count += (unsigned int)groups[i].targets.size();
+
+	return count;
+}
+
+
+
+//--- Methods ---//
+TweenID TweenEngine::moveTo(Node* target, const Vec2& position, float duration, TweenEasing easing, float delay)
+{
+	float values[3] = { position.x, position.y, 0.0f };
+	return addTween(TweenProperty::Position, target, values, duration, easing, delay);
+}
+
+TweenID TweenEngine::scaleTo(Node* target, float scale, float duration, TweenEasing easing, float delay)
+{
+	float values[3] = { scale, 0.0f, 0.0f };
+	return addTween(TweenProperty::Scale, target, values, duration, easing, delay);
+}
+
+TweenID TweenEngine::rotateTo(Node* target, float degrees, float duration, TweenEasing easing, float delay)
+{
+	float values[3] = { degrees, 0.0f, 0.0f };
+	return addTween(TweenProperty::Rotation, target, values, duration, easing, delay);
+}
+
+TweenID TweenEngine::fadeTo(Node* target, GLubyte opacity, float duration, TweenEasing easing, float delay)
+{
+	float values[3] = { (float)opacity, 0.0f, 0.0f };
+	return addTween(TweenProperty::Opacity, target, values, duration, easing, delay);
+}
+
+TweenID TweenEngine::tintTo(Node* target, const Color3B& color, float duration, TweenEasing easing, float delay)
+{
+	float values[3] = { (float)color.r, (float)color.g, (float)color.b };
+	return addTween(TweenProperty::Color, target, values, duration, easing, delay);
+}
+
+void TweenEngine::stop(TweenID id)
+{
+	if (!isActive(id))
+		return;
+
+	const TweenHandle& handle = handles[id & HANDLE_INDEX_MASK];
+	TweenProperty property = handle.property;
+	Node* target = groups[(int)property].targets[handle.index];
+
+	removeTween(property, handle.index);
+	target->release();
+}
+
+void TweenEngine::stopAll(Node* target)
+{
+	for (int i = 0; i < (int)TweenProperty::NumProperties; i++)
+	{
+		TweenGroup& group = groups[i];
+
+		//Go backwards so the tween swapped into a removed one's place has already been checked
+		for (int j = (int)group.targets.size() - 1; j >= 0; j--)
+		{
+			if (group.targets[j] == target)
+			{
+				removeTween((TweenProperty)i, (unsigned int)j);
+				target->release();
+			}
+		}
+	}
+}
+
+void TweenEngine::stopAll()
+{
+	for (int i = 0; i < (int)TweenProperty::NumProperties; i++)
+	{
+		TweenGroup& group = groups[i];
+
+		while (!group.targets.empty())
+		{
+			Node* target = group.targets.back();
+			removeTween((TweenProperty)i, (unsigned int)group.targets.size() - 1);
+			target->release();
+		}
+	}
+}
+
+void TweenEngine::update(float deltaTime)
+{
+	//Update every property's tweens in turn
+	for (int i = 0; i < (int)TweenProperty::NumProperties; i++)
+		updateGroup((TweenProperty)i, deltaTime);
+
+	//Now that the arrays aren't being looped over, it is safe to run the callbacks. They are allowed to start or stop tweens
+	for (unsigned int i = 0; i < finishedCallbacks.size(); i++)
+		finishedCallbacks[i]();
+
+	finishedCallbacks.clear();
+
+	//Let go of the finished nodes last, in case a callback still needed them
+	for (unsigned int i = 0; i < finishedTargets.size(); i++)
+		finishedTargets[i]->release();
+
+	finishedTargets.clear();
+}
+
+
+
+//--- Singleton Instance ---//
+TweenEngine* TweenEngine::getInstance()
+{
+	//Generate the singleton if it hasn't been created yet
+	if (!inst)
+		inst = new TweenEngine();
+
+	//Return the singleton
+	return inst;
+}
+
+
+
+//--- Utility Functions ---//
+TweenID TweenEngine::addTween(TweenProperty property, Node* target, const float* values, float duration, TweenEasing easing, float delay)
+{
+	if (!target)
+		return INVALID_TWEEN;
+
+	//Reuse a handle if there is one free
+	unsigned int handleIndex;
+
+	if (!freeHandles.empty())
+	{
+		handleIndex = freeHandles.back();
+		freeHandles.pop_back();
+	}
+	else
+	{
+		//Out of room in the ID
+		if (handles.size() > HANDLE_INDEX_MASK)
+			return INVALID_TWEEN;
+
+		handleIndex = (unsigned int)handles.size();
+		handles.push_back({ property, 0, 0, false });
+	}
+
+	TweenGroup& group = groups[(int)property];
+	TweenHandle& handle = handles[handleIndex];
+	handle.property = property;
+	handle.index = (unsigned int)group.targets.size();
+	handle.isActive = true;
+
+	TweenID id = handleIndex | (handle.generation << HANDLE_INDEX_BITS);
+
+	//Add the tween to the end of every array. Once the arrays have grown big enough, push_back never allocates again
+	const float* curve = EASING_CURVES[(int)easing];
+	group.targets.push_back(target);
+	group.ids.push_back(id);
+	group.elapsed.push_back(0.0f);
+	group.delay.push_back(std::max(delay, 0.0f));
+	group.inverseDuration.push_back(1.0f / std::max(duration, MIN_DURATION));
+	group.curveA.push_back(curve[0]);
+	group.curveB.push_back(curve[1]);
+	group.curveC.push_back(curve[2]);
+	group.progress.push_back(0.0f);
+	group.isStarted.push_back(0);
+	group.onComplete.push_back(nullptr);
+
+	//The start values are read once the delay is over. Until then, fill them with the end values so the math never sees garbage
+	for (unsigned int i = 0; i < 3; i++)
+	{
+		group.startValues[i].push_back(values[i]);
+		group.endValues[i].push_back(values[i]);
+		group.currentValues[i].push_back(values[i]);
+	}
+
+	group.numWaiting++;
+
+	//Keep the node alive while it is being tweened, the same as an action does
+	target->retain();
+
+	return id;
+}
+
+void TweenEngine::removeTween(TweenProperty property, unsigned int index)
+{
+	TweenGroup& group = groups[(int)property];
+	unsigned int last = (unsigned int)group.targets.size() - 1;
+
+	//Free the handle. Bumping the generation makes any old copies of the ID invalid
+	unsigned int handleIndex = group.ids[index] & HANDLE_INDEX_MASK;
+	handles[handleIndex].isActive = false;
+	handles[handleIndex].generation = (handles[handleIndex].generation + 1) & GENERATION_MASK;
+	freeHandles.push_back(handleIndex);
+
+	if (!group.isStarted[index])
+		group.numWaiting--;
+
+	//Move the last tween into this one's place so the arrays stay packed
+	if (index != last)
+	{
+		group.targets[index] = group.targets[last];
+		group.ids[index] = group.ids[last];
+		group.elapsed[index] = group.elapsed[last];
+		group.delay[index] = group.delay[last];
+		group.inverseDuration[index] = group.inverseDuration[last];
+		group.curveA[index] = group.curveA[last];
+		group.curveB[index] = group.curveB[last];
+		group.curveC[index] = group.curveC[last];
+		group.progress[index] = group.progress[last];
+		group.isStarted[index] = group.isStarted[last];
+		group.onComplete[index] = std::move(group.onComplete[last]);
+
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			group.startValues[i][index] = group.startValues[i][last];
+			group.endValues[i][index] = group.endValues[i][last];
+			group.currentValues[i][index] = group.currentValues[i][last];
+		}
+
+		handles[group.ids[index] & HANDLE_INDEX_MASK].index = index;
+	}
+
+	group.targets.pop_back();
+	group.ids.pop_back();
+	group.elapsed.pop_back();
+	group.delay.pop_back();
+	group.inverseDuration.pop_back();
+	group.curveA.pop_back();
+	group.curveB.pop_back();
+	group.curveC.pop_back();
+	group.progress.pop_back();
+	group.isStarted.pop_back();
+	group.onComplete.pop_back();
+
+	for (unsigned int i = 0; i < 3; i++)
+	{
+		group.startValues[i].pop_back();
+		group.endValues[i].pop_back();
+		group.currentValues[i].pop_back();
+	}
+}
+
+void TweenEngine::updateGroup(TweenProperty property, float deltaTime)
+{
+	TweenGroup& group = groups[(int)property];
+	unsigned int count = (unsigned int)group.targets.size();
+
+	if (count == 0)
+		return;
+
+	//Grab raw pointers so the compiler knows the loops below are simple array math it can vectorize
+	float* elapsed = group.elapsed.data();
+	const float* delay = group.delay.data();
+	const float* inverseDuration = group.inverseDuration.data();
+	const float* curveA = group.curveA.data();
+	const float* curveB = group.curveB.data();
+	const float* curveC = group.curveC.data();
+	float* progress = group.progress.data();
+
+	//Advance the time
+	for (unsigned int i = 0; i < count; i++)
+		elapsed[i] += deltaTime;
+
+	//Read the start values of any tweens whose delay just ended. Skipped completely when nothing is waiting
+	if (group.numWaiting > 0)
+	{
+		for (unsigned int i = 0; i < count; i++)
+		{
+			if (!group.isStarted[i] && elapsed[i] >= delay[i])
+			{
+				float values[3];
+				readValues(property, group.targets[i], values);
+
+				for (unsigned int j = 0; j < group.numValues; j++)
+					group.startValues[j][i] = values[j];
+
+				group.isStarted[i] = 1;
+				group.numWaiting--;
+			}
+		}
+	}
+
+	//Work out how far along each tween is, then ease it. No if statements so every tween takes the same path
+	for (unsigned int i = 0; i < count; i++)
+	{
+		float t = (elapsed[i] - delay[i]) * inverseDuration[i];
+		t = std::min(std::max(t, 0.0f), 1.0f);
+		progress[i] = ((curveA[i] * t + curveB[i]) * t + curveC[i]) * t;
+	}
+
+	//Blend between the start and end values, one value at a time
+	for (unsigned int j = 0; j < group.numValues; j++)
+	{
+		const float* startValues = group.startValues[j].data();
+		const float* endValues = group.endValues[j].data();
+		float* currentValues = group.currentValues[j].data();
+
+		for (unsigned int i = 0; i < count; i++)
+			currentValues[i] = startValues[i] + (endValues[i] - startValues[i]) * progress[i];
+	}
+
+	writeGroup(property);
+
+	//Remove the finished tweens. Go backwards so the tween swapped into a removed one's place has already been checked
+	for (int i = (int)count - 1; i >= 0; i--)
+	{
+		if (!group.isStarted[i] || (elapsed[i] - delay[i]) * inverseDuration[i] < 1.0f)
+			continue;
+
+		//Save the callback and node for after every group is done
+		if (group.onComplete[i])
+			finishedCallbacks.push_back(std::move(group.onComplete[i]));
+
+		finishedTargets.push_back(group.targets[i]);
+		removeTween(property, (unsigned int)i);
+	}
+}
+
+void TweenEngine::writeGroup(TweenProperty property)
+{
+	TweenGroup& group = groups[(int)property];
+	unsigned int count = (unsigned int)group.targets.size();
+	Node** targets = group.targets.data();
+	const uint8_t* isStarted = group.isStarted.data();
+	const float* values0 = group.currentValues[0].data();
+	const float* values1 = group.currentValues[1].data();
+	const float* values2 = group.currentValues[2].data();
+
+	//Pick the property once, then set it on every node in one tight loop
+	switch (property)
+	{
+	case TweenProperty::Position:
+		for (unsigned int i = 0; i < count; i++)
+			if (isStarted[i])
+				targets[i]->setPosition(values0[i], values1[i]);
+		break;
+
+	case TweenProperty::Scale:
+		for (unsigned int i = 0; i < count; i++)
+			if (isStarted[i])
+				targets[i]->setScale(values0[i]);
+		break;
+
+	case TweenProperty::Rotation:
+		for (unsigned int i = 0; i < count; i++)
+			if (isStarted[i])
+				targets[i]->setRotation(values0[i]);
+		break;
+
+	case TweenProperty::Opacity:
+		for (unsigned int i = 0; i < count; i++)
+			if (isStarted[i])
+				targets[i]->setOpacity((GLubyte)std::min(std::max(values0[i] + 0.5f, 0.0f), 255.0f));
+		break;
+
+	case TweenProperty::Color:
+		for (unsigned int i = 0; i < count; i++)
+			if (isStarted[i])
+				targets[i]->setColor(Color3B((GLubyte)std::min(std::max(values0[i] + 0.5f, 0.0f), 255.0f), (GLubyte)std::min(std::max(values1[i] + 0.5f, 0.0f), 255.0f), (GLubyte)std::min(std::max(values2[i] + 0.5f, 0.0f), 255.0f)));
+		break;
+
+	default:
+		break;
+	}
+}
+
+void TweenEngine::readValues(TweenProperty property, Node* target, float* values)
+{
+	switch (property)
+	{
+	case TweenProperty::Position:
+		values[0] = target->getPositionX();
+		values[1] = target->getPositionY();
+		break;
+
+	case TweenProperty::Scale:
+		values[0] = target->getScaleX();
+		break;
+
+	case TweenProperty::Rotation:
+		values[0] = target->getRotation();
+		break;
+
+	case TweenProperty::Opacity:
+		values[0] = (float)target->getOpacity();
+		break;
+
+	case TweenProperty::Color:
+		values[0] = (float)target->getColor().r;
+		values[1] = (float)target->getColor().g;
+		values[2] = (float)target->getColor().b;
+		break;
+
+	default:
+		break;
+	}
+}
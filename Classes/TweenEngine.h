@@ -0,0 +1,255 @@
+/*
+============================================================
+	Tween Engine:
+		- A fast replacement for MoveTo, ScaleTo, RotateTo, FadeTo and TintTo when you have thousands of things animating at once
+			> Cocos2D actions are each their own object on the heap with a virtual step() call every frame. This stores every tween of the same property together in plain arrays instead
+			> Every frame, all of the tweens are advanced, eased and blended in simple loops the compiler can turn into SIMD code, then the results are written to the nodes in one pass
+			> Finished tweens are swapped out of the arrays and their slots are reused, so nothing is allocated once the arrays have grown to the busiest frame
+		- Start a tween with one of the ...To() functions. It returns an ID you can use to stop it or to run something when it finishes
+			> Ex: TweenID id = TWEENS->moveTo(sprite, Vec2(100.0f, 200.0f), 0.5f, TweenEasing::QuadOut); TWEENS->setOnComplete(id, [](){ ... });
+		- Call TWEENS->update(deltaTime) once per frame from your scene's update()
+		- Every easing curve is a cubic (a*t^3 + b*t^2 + c*t) so they can all be evaluated by the same loop without any if statements
+
+	Usage:
+		- You are free to use this class for the case studies and for GDW
+		- You are free to edit / overwrite any or all of this class
+			> It is simply here to make your life easier
+		- You must leave this comment block at the top of the header
+
+	Note:
+		- This class uses the Singleton design pattern
+			> Do not ever make more than one instance of this class in its current form
+			> You don't ever have to call the constructor for this class. Simply start using it and it will build itself
+			> There is a macro "TWEENS->" that provides a shortcut for getting the singleton instance
+		- Nodes are retained while they are being tweened, the same as with actions. Removing a node from the scene doesn't stop its tweens, call stopAll(node) for that
+		- The starting value is read from the node when the tween starts (after its delay), so tweens can be queued one after another with delays
+============================================================
+*/
+
+#ifndef TWEENENGINE_H
+#define TWEENENGINE_H
+
+//Core Libraries
+#include <cstdint>
+#include <vector>
+#include <functional>
+
+//3rd Party Libraries
+#include "cocos2d.h"
+
+//Namespaces
+using namespace cocos2d;
+
+//Useful shorthands
+typedef unsigned int TweenID; //A handle to a tween. Stays valid until the tween finishes or is stopped
+#define INVALID_TWEEN 0xFFFFFFFF //Returned when a tween couldn't be started
+
+/*
+	Tween Property Enum
+	- The node properties that can be tweened. Each one has its own set of arrays
+*/
+enum class TweenProperty
+{
+	Position, //setPosition(), 2 values
+	Scale, //setScale(), 1 value
+	Rotation, //setRotation(), 1 value
+	Opacity, //setOpacity(), 1 value
+	Color, //setColor(), 3 values
+	NumProperties //Not a property. Used to know how many there are
+};
+
+/*
+	Tween Easing Enum
+	- How the tween speeds up and slows down
+*/
+enum class TweenEasing
+{
+	Linear, //Constant speed
+	QuadIn, //Starts slow, ends fast
+	QuadOut, //Starts fast, ends slow
+	CubicIn, //Like QuadIn, but stronger
+	CubicOut, //Like QuadOut, but stronger
+	SmoothStep, //Starts and ends slow
+	BackIn, //Pulls back a little before going
+	BackOut, //Overshoots a little before settling
+	NumEasings //Not an easing. Used to know how many there are
+};
+
+
+
+/*
+	Tween Engine Class:
+	> Setters
+		- Set a callback for when a tween finishes
+	> Getters
+		- Get if a tween is still running
+		- Get the number of running tweens
+	> Methods
+		- Start tweens for position, scale, rotation, opacity and color
+		- Stop tweens
+		- Update every tween (call once per frame)
+*/
+class TweenEngine
+{
+protected:
+	//--- Constructor ---//
+	TweenEngine(); //The constructor is protected so only one instance of this class can ever exist. This is called the singleton pattern.
+
+public:
+	//--- Destructor ---//
+	~TweenEngine();
+
+
+
+	//--- Setters ---//
+	/*
+		Run a function when a tween finishes. It isn't run if the tween is stopped
+
+		@param ID -> The tween
+		@param Callback -> The function to run. Ex: [sprite]() { sprite->removeFromParent(); }
+	*/
+	void setOnComplete(TweenID id, const std::function<void()>& callback);
+
+
+
+	//--- Getters ---//
+	/*
+		@param ID -> The tween to check
+		@return Returns -> True if the tween is still running (or waiting on its delay)
+	*/
+	bool isActive(TweenID id) const;
+
+	/*
+		@return Returns -> The number of tweens running right now, across every property
+	*/
+	unsigned int getActiveCount() const;
+
+
+
+	//--- Methods ---//
+	/*
+		Move a node to a position over time. The same as MoveTo
+
+		@param Target -> The node to move
+		@param Position -> Where the node ends up
+		@param Duration -> How long it takes, in seconds
+		@param Easing (optional) -> Defaulted to Linear. How the movement speeds up and slows down
+		@param Delay (optional) -> Defaulted to 0. How many seconds to wait before starting
+		@return Returns -> The ID of the new tween
+	*/
+	TweenID moveTo(Node* target, const Vec2& position, float duration, TweenEasing easing = TweenEasing::Linear, float delay = 0.0f);
+
+	/*
+		Scale a node over time. The same as ScaleTo. The parameters are the same as moveTo()
+	*/
+	TweenID scaleTo(Node* target, float scale, float duration, TweenEasing easing = TweenEasing::Linear, float delay = 0.0f);
+
+	/*
+		Rotate a node to an angle in degrees over time. The same as RotateTo (without picking the shortest way around). The parameters are the same as moveTo()
+	*/
+	TweenID rotateTo(Node* target, float degrees, float duration, TweenEasing easing = TweenEasing::Linear, float delay = 0.0f);
+
+	/*
+		Fade a node to an opacity (0 - 255) over time. The same as FadeTo. The parameters are the same as moveTo()
+	*/
+	TweenID fadeTo(Node* target, GLubyte opacity, float duration, TweenEasing easing = TweenEasing::Linear, float delay = 0.0f);
+
+	/*
+		Change a node's color over time. The same as TintTo. The parameters are the same as moveTo()
+	*/
+	TweenID tintTo(Node* target, const Color3B& color, float duration, TweenEasing easing = TweenEasing::Linear, float delay = 0.0f);
+
+	/*
+		Stop a tween where it is. Its completion callback is not run
+
+		@param ID -> The tween to stop
+	*/
+	void stop(TweenID id);
+
+	/*
+		Stop every tween on a node. Call this before removing a node that might still be tweening
+
+		@param Target -> The node
+	*/
+	void stopAll(Node* target);
+
+	/*
+		Stop every tween on every node
+	*/
+	void stopAll();
+
+	/*
+		Advance every tween and write the results to the nodes. Finished tweens are removed and their callbacks are run. Call this once per frame from your scene's update()
+
+		@param DeltaTime -> The time since the last frame in seconds
+	*/
+	void update(float deltaTime);
+
+
+
+	//--- Singleton Instance ---//
+	/*
+		Get the instance of the singleton. You shouldn't ever need to call this directly since the macro (TWEENS->) automatically calls it
+
+		@return Returns -> The singleton instance of this class. This is the ONLY instance of this class so intrefacing HAS to be done through this instance.
+	*/
+	static TweenEngine* getInstance();
+
+private:
+	/*
+		Tween Group Struct
+		- Every tween of one property, stored as one array per value ("structure of arrays")
+		- Index i in every array is the same tween
+	*/
+	struct TweenGroup
+	{
+		unsigned int numValues; //How many floats the property has. Ex: 2 for position
+		unsigned int numWaiting; //How many tweens are still waiting on their delay. Their start values haven't been read yet
+
+		std::vector<Node*> targets; //The node each tween is changing
+		std::vector<TweenID> ids; //The handle of each tween
+		std::vector<float> elapsed; //How long each tween has been running, including its delay
+		std::vector<float> delay; //How long each tween waits before starting
+		std::vector<float> inverseDuration; //1 divided by the duration. Multiplying is faster than dividing
+		std::vector<float> curveA, curveB, curveC; //The cubic easing curve: a*t^3 + b*t^2 + c*t
+		std::vector<float> progress; //The eased progress of each tween from 0 to 1. Rebuilt every update
+		std::vector<uint8_t> isStarted; //1 once the delay is over and the start values have been read
+		std::vector<float> startValues[3]; //The values when each tween started. One array per value
+		std::vector<float> endValues[3]; //The values each tween ends at
+		std::vector<float> currentValues[3]; //The values written to the nodes this frame
+		std::vector<std::function<void()>> onComplete; //The callback for each tween. Empty if there isn't one
+	};
+
+	/*
+		Tween Handle Struct
+		- Where a tween's data lives. A handle's slot is reused after its tween ends, so the generation is used to tell an old ID from a new one
+	*/
+	struct TweenHandle
+	{
+		TweenProperty property; //Which group the tween is in
+		unsigned int index; //Where the tween is in the group's arrays
+		unsigned int generation; //Counts up every time the handle is reused
+		bool isActive; //True while the handle belongs to a running tween
+	};
+
+	//--- Private Data ---//
+	TweenGroup groups[(int)TweenProperty::NumProperties]; //One group per property
+	std::vector<TweenHandle> handles; //Every handle, running or not
+	std::vector<unsigned int> freeHandles; //Handles that can be reused
+	std::vector<std::function<void()>> finishedCallbacks; //The callbacks of the tweens that finished this frame. Run after every group is updated so they can safely start new tweens
+	std::vector<Node*> finishedTargets; //The nodes of the tweens that finished this frame. Released after the callbacks have run
+
+	//--- Singleton Instance ---//
+	static TweenEngine* inst; //The singleton instance of this class. Ie: the only instance that can ever exist
+
+	//--- Utility Functions ---//
+	TweenID addTween(TweenProperty property, Node* target, const float* endValues, float duration, TweenEasing easing, float delay); //Adds a tween to the end of its group
+	void removeTween(TweenProperty property, unsigned int index); //Swaps the last tween in the group into this one's place
+	void updateGroup(TweenProperty property, float deltaTime); //Advances, eases and writes back every tween in a group
+	void writeGroup(TweenProperty property); //Writes the current values of every started tween in a group to its node, one property at a time
+	static void readValues(TweenProperty property, Node* target, float* values); //Gets the current values of the property from the node
+};
+
+#define TWEENS TweenEngine::getInstance() //Macro to make using the class easier. Automatically gets the singleton instance for you
+
+#endif